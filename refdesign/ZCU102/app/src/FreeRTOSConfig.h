@@ -125,6 +125,7 @@
 #define INCLUDE_pcTaskGetTaskName            1
 #define INCLUDE_xTaskGetIdleTaskHandle		 1
 #define INCLUDE_uxTaskGetStackHighWaterMark  1
+#define INCLUDE_xTaskAbortDelay              1
 #define configTIMER_ID XPAR_XTTCPS_0_DEVICE_ID
 
 #define configTIMER_BASEADDR XPAR_XTTCPS_0_BASEADDR
@@ -183,6 +184,74 @@ void FreeRTOS_ClearTickInterrupt( void );
 //CPU Load Update Tate in Ticks (shall be chosen enough to not cause 32-bit counter overflows)
 #define configPSI_CPU_LOAD_UPDATE_RATE_TICKS 100
 
+//High resolution delays and timeouts (microsecond resolution independent of the tick rate)
+#define configPSI_USE_HRTIMER 0
+#define configPSI_TIMER_HRTIMER_ID XPAR_XTTCPS_2_DEVICE_ID
+#define configPSI_TIMER_HRTIMER_INTR XPAR_XTTCPS_2_INTR
+
+//Kernel benchmarks (context switch and tick cost)
+#define configPSI_USE_BENCHMARK 0
+
+//MPU stack guard (replaces the configCHECK_FOR_STACK_OVERFLOW checks)
+#define configPSI_USE_MPU_STACK_GUARD 0
+
+//Inter-core message queue for RPU split mode (IPI channel of this core and mask of the other core)
+#define configPSI_USE_IPC 0
+#define configPSI_IPC_IPI_ID XPAR_XIPIPSU_0_DEVICE_ID
+#define configPSI_IPC_IPI_INTR XPAR_XIPIPSU_0_INT_ID
+#define configPSI_IPC_PEER_IPI_MASK XPAR_XIPIPS_TARGET_PSU_CORTEXR5_1_CH0_MASK
+
+//Correlation of the PsiFreeRTOS time base with the system counter used by the APU
+#define configPSI_USE_TIMESYNC 0
+
+//Tick interrupt without table dispatch and driver calls
+#define configPSI_USE_FAST_TICK 0
+
+//High water marks of the exception mode stacks and maximum interrupt nesting
+#define configPSI_USE_EXCEPTION_STACK_STATS 0
+
+//Lateness of the tick interrupt, lost and pended ticks
+#define configPSI_USE_TICK_STATS 0
+
+//Rate monitoring of interrupts, disabling interrupts exceeding their limit
+#define configPSI_USE_IRQ_GUARD 0
+
+//Work queues for deferred interrupt processing
+#define configPSI_USE_WORKQUEUE 0
+
+//Memory copies with the ZDMA (first channel and its interrupt)
+#define configPSI_USE_DMA 0
+#define configPSI_DMA_DEVICE_ID_FIRST XPAR_XZDMA_0_DEVICE_ID
+#define configPSI_DMA_INTR_FIRST XPAR_XADMAPSU_0_INTR
+
+//Earliest deadline first scheduling of one priority level
+#define configPSI_USE_EDF 0
+#define configPSI_EDF_PRIORITY 1
+
+//Mutexes with immediate priority ceiling
+#define configPSI_USE_CEILING_MUTEX 0
+
+//Timing wheel for blocked tasks with timeout
+#define configPSI_USE_DELAY_WHEEL 0
+
+//Batched processing of the ticks pended while the scheduler was suspended
+#define configPSI_USE_TICK_CATCH_UP 0
+
+//CPU reservations (budget per period) for tasks
+#define configPSI_USE_RESERVATION 0
+
+//Pre-allocated TCB and stack slots for tasks created at runtime
+#define configPSI_USE_TASK_POOL 0
+
+//Per task round robin quantum
+#define configPSI_USE_TIME_SLICE_QUANTUM 0
+
+//Per task preemption threshold
+#define configPSI_USE_PREEMPTION_THRESHOLD 0
+
+//Notification values per task
+#define configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES 1
+
 
 #ifdef FREERTOS_ENABLE_TRACE
 #include "FreeRTOSSTMTrace.h"
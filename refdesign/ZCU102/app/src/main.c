@@ -3,8 +3,14 @@
 #include <xil_printf.h>
 #include <stdbool.h>
 #include "PsiFreeRTOS.h"
+#include "PsiFreeRTOS_Bench.h"
 #include <stdio.h>
 
+//Interrupt latency benchmark: samples per wake-up method and additional background load
+#define LATENCY_SAMPLES			100000
+#define LATENCY_LOAD_TASKS		2
+#define LATENCY_LOAD_CYCLES		100000
+
 void Task_NoLoad(void* arg_p) {
 	for (;;) {
 		PsiFreeRTOS_printf("%s Loop\r\n", pcTaskGetName(NULL));
@@ -68,6 +74,10 @@ void Task_Menu(void* arg_p) {
 	PsiFreeRTOS_printf("m Failing memory allocation\r\n");
 	PsiFreeRTOS_printf("h Print Heap\r\n");
 	PsiFreeRTOS_printf("i Infinite loop detection\r\n");
+	#if (configPSI_USE_BENCHMARK == 1)
+		PsiFreeRTOS_printf("b Kernel benchmark\r\n");
+		PsiFreeRTOS_printf("l Interrupt latency benchmark\r\n");
+	#endif
 	char c = inbyte();
 
 	//Create tasks always required
@@ -87,6 +97,13 @@ void Task_Menu(void* arg_p) {
 	case 'm':
 		xTaskCreate(Task_MallocFail, "MallocTask", 400, NULL, 1, NULL);
 		break;
+	#if (configPSI_USE_BENCHMARK == 1)
+	case 'l':
+		for (int i = 0; i < LATENCY_LOAD_TASKS; i++) {
+			xTaskCreate(Task_Load, "LatencyLoad", 400, (void*)LATENCY_LOAD_CYCLES, 1, NULL);
+		}
+		break;
+	#endif
 	case 'i':
 		xTaskCreate(Task_InfiniteLoop, "Infinite", 400, NULL, 1, NULL);
 	default:
@@ -121,6 +138,14 @@ void Task_Menu(void* arg_p) {
 		PsiFreeRTOS_printf("AFTER NEW TASK CREATED\r\n");
 		PsiFreeRTOS_PrintHeap();
 		break;
+	#if (configPSI_USE_BENCHMARK == 1)
+	case 'b':
+		PsiFreeRTOS_BenchRun();
+		break;
+	case 'l':
+		PsiFreeRTOS_BenchIrqLatencyRun(LATENCY_SAMPLES);
+		break;
+	#endif
 	default:
 		break;
 	}
@@ -56,6 +56,9 @@ extern "C" {
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
+/* PSI specific: defaults for all optional configPSI_xxx settings. */
+#include "PsiFreeRTOS_Config.h"
+
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
@@ -1017,8 +1020,8 @@ typedef struct xSTATIC_TCB
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if( ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) || ( portUSING_MPU_WRAPPERS == 1 ) )
 		uint8_t			uxDummy20;
@@ -1028,6 +1031,30 @@ typedef struct xSTATIC_TCB
 		uint8_t ucDummy21;
 	#endif
 
+	/* PSI specific: EDF scheduling. */
+	#if( configPSI_USE_EDF == 1 )
+		TickType_t		xDummyEdf[ 4 ];
+		UBaseType_t		uxDummyEdf;
+	#endif
+
+	/* PSI specific: CPU reservation. */
+	#if( configPSI_USE_RESERVATION == 1 )
+		TickType_t		xDummyRes[ 2 ];
+		uint32_t		ulDummyRes[ 2 ];
+		UBaseType_t		uxDummyRes;
+		uint8_t			ucDummyRes[ 2 ];
+	#endif
+
+	/* PSI specific: round robin quantum. */
+	#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+		UBaseType_t		uxDummyQuantum[ 2 ];
+	#endif
+
+	/* PSI specific: preemption threshold. */
+	#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxDummyThreshold;
+	#endif
+
 } StaticTask_t;
 
 /*
@@ -1071,6 +1098,11 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	/* PSI specific: priority ceiling mutexes. */
+	#if( configPSI_USE_CEILING_MUTEX == 1 )
+		UBaseType_t uxDummyCeiling;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -6,9 +6,17 @@
  * Includes
  *******************************************************************************************/
 #include "PsiFreeRTOS.h"
+#include "PsiFreeRTOS_Internal.h"
+#include "PsiFreeRTOS_HrTimer.h"
+#include "PsiFreeRTOS_Ipc.h"
+#include "PsiFreeRTOS_TimeSync.h"
+#include "PsiFreeRTOS_Dma.h"
+#include "PsiFreeRTOS_IrqGuard.h"
 #include "FreeRTOSConfig.h"
 #include <stdbool.h>
+#include <string.h>
 #include "xttcps.h"
+#include "xil_exception.h"
 #include <xparameters.h>
 #include <xparameters_ps.h>
 #include "timers.h"
@@ -26,23 +34,42 @@ static TickType_t cpuMeasStartTicks;
 static unsigned long remainingHeap;
 static volatile TickType_t lastIdleTime;
 static XTtcPs xTimerInstance;
+static volatile bool timeBaseRunning;
+static volatile uint64_t timeBaseLast;
+static uint32_t timeBaseFreqHz;
+#if (configGENERATE_RUN_TIME_STATS) && (configPSI_USE_FAST_TICK == 1)
+	static TickType_t timeBaseLastTick;
+#endif
 static PsiFreeRTOS_FatalHandler fatalErrorHandler_p;
 static PsiFreeRTOS_TickHandler userTickHandler_p;
 static bool infLoopDet;
+static const char* coreName;
+#if (configPSI_USE_TICK_STATS == 1)
+	static PsiFreeRTOS_TickStats tickStats;
+	static uint64_t tickLatenessSumNs;
+	static uint32_t tickNsPerCountQ16;
+	static UBaseType_t tickLastPended;
+	#if (configGENERATE_RUN_TIME_STATS)
+		static uint64_t tickLastTime;
+	#endif
+#endif
+#if (configPSI_USE_EDF == 1)
+	static PsiFreeRTOS_DeadlineMissHandler deadlineMissHandler_p;
+	static volatile uint32_t edfDeadlineMisses;
+#endif
 SemaphoreHandle_t PsiFreeRTOS_printMutex;
 
 /*******************************************************************************************
  * Private Helper Functions
  *******************************************************************************************/
-#define printfSel(unsafe, ...) { \
-	if (unsafe) { \
-		printfInt(__VA_ARGS__); \
-	} \
-	else { \
-		PsiFreeRTOS_printf(__VA_ARGS__); \
-	}}
-
 #if (configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS)
+	//The timer is not stopped while the counters of the tasks are read (it is also the time base),
+	//..so a task can have slightly more runtime than the sum measured before.
+	static uint8_t CpuLoadPercent(const uint32_t runTime, const unsigned long runSumPercent) {
+		const uint32_t load = runTime/runSumPercent;
+		return (load > 100) ? 100 : (uint8_t)load;
+	}
+
 	void PsiFreeRTOS_PrintCpuUsageInternal(bool isIrqContext) {
 		//Checks
 		if ((!configUSE_TRACE_FACILITY) || (!configGENERATE_RUN_TIME_STATS)) {
@@ -51,10 +78,9 @@ SemaphoreHandle_t PsiFreeRTOS_printMutex;
 
 		//Implementation
 		TaskStatus_t status;
-		XTtcPs_Stop( &xTimerInstance );
 		unsigned long runSum = PsiFreeRTOS_GET_RUN_TIME_COUNTER_VALUE() - cpuMeasStartIncr;
 		unsigned long runSumPercent = runSum/100;
-		printfSel(isIrqContext, "PsiFreeRTOS CPU-Usage:\r\n");
+		printfSel(isIrqContext, "PsiFreeRTOS CPU-Usage%s:\r\n", coreName);
 		printfSel(isIrqContext, "%-20s %4s %5s %10s\r\n", "Name", "CPU%", "Prio", "Cycles");
 		for (uint16_t i = 0; ; i++) {
 			if (!isIrqContext) {
@@ -76,7 +102,7 @@ SemaphoreHandle_t PsiFreeRTOS_printMutex;
 				cpuTicks = taskCpuTicks[i];
 			}
 			else {
-				cpuLoad = (uint8_t)(status.ulRunTimeCounter/runSumPercent);
+				cpuLoad = CpuLoadPercent(status.ulRunTimeCounter, runSumPercent);
 				cpuTicks = status.ulRunTimeCounter;
 			}
 			//Print
@@ -86,21 +112,18 @@ SemaphoreHandle_t PsiFreeRTOS_printMutex;
 									status.uxBasePriority,
 									cpuTicks);
 		}
-		XTtcPs_Start( &xTimerInstance );
 	}
 #endif
 
 #if (configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS)
 	void PsiFreeRTOS_StartCpuUsageMeas() {
 		taskENTER_CRITICAL();
-		XTtcPs_Stop( &xTimerInstance );
 		cpuMeasStartIncr = PsiFreeRTOS_GET_RUN_TIME_COUNTER_VALUE();
 		cpuMeasStartTicks = xTaskGetTickCount();
 		for (uint16_t i = 0; i < taskCount; i++) {
 			TaskHandle_t hndl = allTasks[i];
 			vTaskClearRunTimeCounter(hndl);
 		}
-		XTtcPs_Start( &xTimerInstance );
 		taskEXIT_CRITICAL();
 
 	}
@@ -176,6 +199,9 @@ void PsiFreerRTOS_CONFIGURE_TIMER_FOR_RUN_TIME_STATS() {
 	XTtcPs_SetOptions( &xTimerInstance, XTTCPS_OPTION_WAVE_DISABLE );
 	/* Enable the interrupt for timer. */
 	XTtcPs_Start( &xTimerInstance );
+	timeBaseFreqHz = pxTimerConfig->InputClockHz;
+	timeBaseLast = 0;
+	timeBaseRunning = true;
 }
 
 unsigned long PsiFreeRTOS_GET_RUN_TIME_COUNTER_VALUE() {
@@ -204,6 +230,82 @@ void vApplicationMallocFailedHook() {
 	for(;;){}
 }
 
+#if (configPSI_USE_EDF == 1)
+	void vApplicationEdfDeadlineMissHook(TaskHandle_t xTask, TickType_t xLateness) {
+		edfDeadlineMisses++;
+		if (NULL != deadlineMissHandler_p) {
+			(*deadlineMissHandler_p)(xTask, xLateness);
+		}
+		else {
+			PsiFreeRTOS_printf("WARNING: Deadline of '%s' missed by %d ticks\r\n", pcTaskGetName(xTask), xLateness);
+		}
+	}
+#endif
+
+#if (configPSI_USE_MPU_STACK_GUARD == 1)
+	static void PsiFreeRTOS_DataAbortHandler(void* data_p) {
+		//Read the faulting address from the DFAR
+		uint32_t faultAddr;
+		__asm volatile ("MRC p15, 0, %0, c6, c0, 0" : "=r" (faultAddr));
+
+		//Accesses to the MPU stack guard of the running task are stack overflows
+		if ((faultAddr >= ulPortStackGuardBase) && (faultAddr < ulPortStackGuardBase + configPSI_MPU_STACK_GUARD_SIZE)) {
+			vApplicationStackOverflowHook(NULL, (const signed char*)pcTaskGetName(NULL));
+		}
+
+		//Any other data abort is fatal as well
+		printfInt("\r\nERROR: Data Abort at address 0x%08x in '%s' !!!\r\n", faultAddr, pcTaskGetName(NULL));
+		vTaskSuspendAll();
+		if (NULL != fatalErrorHandler_p) {
+			(*fatalErrorHandler_p)(PsiFreeRTOS_FatalReason_DataAbort);
+		}
+		for(;;){}
+	}
+#endif
+
+#if (configPSI_USE_TICK_STATS == 1)
+	//Called from the tick hook
+	static void TickStatsUpdate() {
+		//Lateness (conversion factor is calculated on the first tick, the tick timer is set up
+		//..when the scheduler starts)
+		if (0 == tickNsPerCountQ16) {
+			tickNsPerCountQ16 = (uint32_t)(((1000000000ULL / configTICK_RATE_HZ) << 16) / (ulPortTickInterval + 1));
+		}
+		const uint32_t latenessNs = (uint32_t)(((uint64_t)ulPortTickEntryCount * tickNsPerCountQ16) >> 16);
+		uint32_t bin = latenessNs / configPSI_TICK_STATS_BIN_NS;
+		if (bin >= configPSI_TICK_STATS_BINS) {
+			bin = configPSI_TICK_STATS_BINS - 1;
+		}
+		tickStats.histogram[bin]++;
+		tickStats.ticks++;
+		tickLatenessSumNs += latenessNs;
+		if (latenessNs > tickStats.latenessMaxNs) {
+			tickStats.latenessMaxNs = latenessNs;
+		}
+
+		//Lost ticks (the timer restarts when the tick interrupt is delayed by more than one
+		//..period, this is only visible in the time base)
+		#if (configGENERATE_RUN_TIME_STATS)
+			const uint64_t now = PsiFreeRTOS_TimeGet();
+			const uint64_t period = PsiFreeRTOS_TimeGetFreqHz() / configTICK_RATE_HZ;
+			if ((0 != tickLastTime) && (0 != period) && (now - tickLastTime > period + period/2)) {
+				tickStats.lostTicks += (uint32_t)((now - tickLastTime + period/2) / period) - 1;
+			}
+			tickLastTime = now;
+		#endif
+
+		//Pended ticks (the scheduler was suspended)
+		const UBaseType_t pended = uxTaskGetPendedTicks();
+		if (pended > tickLastPended) {
+			tickStats.pendedTicks += pended - tickLastPended;
+		}
+		if (pended > tickStats.pendedTicksMax) {
+			tickStats.pendedTicksMax = pended;
+		}
+		tickLastPended = pended;
+	}
+#endif
+
 void vApplicationIdleHook() {
 	lastIdleTime = xTaskGetTickCount();
 	//Automatically restart CPU load measurement at the rate selected by the user
@@ -216,7 +318,6 @@ void vApplicationIdleHook() {
 
 			//Safe CPU load results
 			TaskStatus_t status;
-			XTtcPs_Stop( &xTimerInstance );
 			unsigned long runSum = PsiFreeRTOS_GET_RUN_TIME_COUNTER_VALUE() - cpuMeasStartIncr;
 			unsigned long runSumDiv = runSum/100; //Used to calculate runtime in percent
 			for (uint16_t i = 0; ; i++) {
@@ -229,10 +330,9 @@ void vApplicationIdleHook() {
 				taskEXIT_CRITICAL();
 
 				vTaskGetInfo(hndl, &status, pdFALSE, eBlocked);
-				taskCpuLoad[i] = (uint8_t)(status.ulRunTimeCounter/runSumDiv);
+				taskCpuLoad[i] = CpuLoadPercent(status.ulRunTimeCounter, runSumDiv);
 				taskCpuTicks[i] = status.ulRunTimeCounter;
 			}
-			XTtcPs_Start( &xTimerInstance );
 
 			//Restart Measurement
 			PsiFreeRTOS_StartCpuUsageMeas();
@@ -240,7 +340,38 @@ void vApplicationIdleHook() {
 	#endif
 }
 
+//With configPSI_TICK_CATCH_UP_HOOK, the hook is called once for all caught up ticks from task
+//..context. The tick statistics and the interrupt guard expect one call per tick interrupt.
+#if (configPSI_USE_TICK_CATCH_UP == 1) && (configPSI_TICK_CATCH_UP_HOOK == 1)
+	#if (configPSI_USE_TICK_STATS == 1) || (configPSI_USE_IRQ_GUARD == 1)
+		#error configPSI_TICK_CATCH_UP_HOOK must be 0 when configPSI_USE_TICK_STATS or configPSI_USE_IRQ_GUARD is 1
+	#endif
+#endif
+
 void vApplicationTickHook() {
+	//Reading the time base regularly ensures it does not miss a wrap of the 32-bit timer
+	//..(with the fast tick only every configPSI_FAST_TICK_TIMEBASE_TICKS). The elapsed ticks are
+	//..compared since pended ticks are caught up without calling the hook for each of them.
+	#if (configGENERATE_RUN_TIME_STATS)
+		#if (configPSI_USE_FAST_TICK == 1)
+			const TickType_t tick = xTaskGetTickCountFromISR();
+			if (tick - timeBaseLastTick >= configPSI_FAST_TICK_TIMEBASE_TICKS) {
+				timeBaseLastTick = tick;
+				PsiFreeRTOS_TimeGet();
+			}
+		#else
+			PsiFreeRTOS_TimeGet();
+		#endif
+	#endif
+
+	#if (configPSI_USE_IRQ_GUARD == 1)
+		PsiFreeRTOS_IrqGuardTick();
+	#endif
+
+	#if (configPSI_USE_TICK_STATS == 1)
+		TickStatsUpdate();
+	#endif
+
 	if (infLoopDet) {
 		const TickType_t currentTime = xTaskGetTickCountFromISR();
 
@@ -252,6 +383,10 @@ void vApplicationTickHook() {
 			#if (configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS)
 				PsiFreeRTOS_PrintCpuUsageInternal(true);
 			#endif
+			//An interrupt firing continuously also starves the idle task
+			#if (configPSI_USE_IRQ_GUARD == 1)
+				PsiFreeRTOS_IrqGuardPrintUnlocked();
+			#endif
 			vTaskSuspendAll();
 			if (NULL != fatalErrorHandler_p) {
 				(*fatalErrorHandler_p)(PsiFreeRTOS_FatalReason_InfiniteLoop);
@@ -281,9 +416,37 @@ void PsiFreeRTOS_Init(	PsiFreeRTOS_FatalHandler fatalHandler_p,
 	remainingHeap = configTOTAL_HEAP_SIZE;
 	lastIdleTime = 0;
 	cpuMeasStartIncr = 0;
+	timeBaseRunning = false;
 	fatalErrorHandler_p = fatalHandler_p;
 	userTickHandler_p = tickHandler_p;
 	infLoopDet = infLoopDetection;
+	//In split mode both cores print statistics, so the core is added to the headers
+	#if (configPSI_USE_IPC == 1)
+		coreName = (0 == ulPortGetCoreID()) ? " (R5_0)" : " (R5_1)";
+	#else
+		coreName = "";
+	#endif
+	#if (configPSI_USE_HRTIMER == 1)
+		PsiFreeRTOS_HrTimerInit();
+	#endif
+	#if (configPSI_USE_IPC == 1)
+		PsiFreeRTOS_IpcInit();
+	#endif
+	#if (configPSI_USE_TIMESYNC == 1)
+		PsiFreeRTOS_TimeSyncInit();
+	#endif
+	#if (configPSI_USE_DMA == 1)
+		PsiFreeRTOS_DmaInit();
+	#endif
+	#if (configPSI_USE_IRQ_GUARD == 1)
+		PsiFreeRTOS_IrqGuardInit();
+	#endif
+	#if (configPSI_USE_EXCEPTION_STACK_STATS == 1)
+		vPortPaintExceptionStacks();
+	#endif
+	#if (configPSI_USE_MPU_STACK_GUARD == 1)
+		Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_DATA_ABORT_INT, PsiFreeRTOS_DataAbortHandler, NULL);
+	#endif
 }
 
 #if INCLUDE_uxTaskGetStackHighWaterMark
@@ -293,7 +456,7 @@ void PsiFreeRTOS_Init(	PsiFreeRTOS_FatalHandler fatalHandler_p,
 			PsiFreeRTOS_printf("INFO: Cannot print Stack Watermark because of FreeRTOS Settings");
 		}
 		//Implementation
-		printfInt("PsiFreeRTOS Stack-Watermarks:\r\n");
+		printfInt("PsiFreeRTOS Stack-Watermarks%s:\r\n", coreName);
 		taskENTER_CRITICAL();
 		for (uint16_t i = 0; i < taskCount; i++) {
 			const TaskHandle_t hndl = allTasks[i];
@@ -306,6 +469,13 @@ void PsiFreeRTOS_Init(	PsiFreeRTOS_FatalHandler fatalHandler_p,
 			taskENTER_CRITICAL();
 		}
 		taskEXIT_CRITICAL();
+		#if (configPSI_USE_EXCEPTION_STACK_STATS == 1)
+			for (uint32_t i = 0; i < portEXCEPTION_STACK_COUNT; i++) {
+				PsiFreeRTOS_printf("%-20s %d (of %d)\r\n", pcPortGetExceptionStackName(i),
+									ulPortGetExceptionStackHighWaterMark(i), ulPortGetExceptionStackSize(i));
+			}
+			PsiFreeRTOS_printf("%-20s %d\r\n", "<Max IRQ Nesting>", ulPortInterruptNestingMax);
+		#endif
 	}
 #endif
 
@@ -325,8 +495,199 @@ void PsiFreeRTOS_Init(	PsiFreeRTOS_FatalHandler fatalHandler_p,
 
 #endif
 
+#if (configGENERATE_RUN_TIME_STATS)
+	uint64_t PsiFreeRTOS_TimeGet() {
+		if (!timeBaseRunning) {
+			return 0;
+		}
+		//Lock-free extension of the 32-bit timer: whoever reads the timer first after a wrap
+		//..increments the upper word. If the read is interrupted by another read, the
+		//..exchange fails and the timer is read again.
+		uint64_t last = __atomic_load_n(&timeBaseLast, __ATOMIC_ACQUIRE);
+		uint64_t now;
+		do {
+			const uint32_t low = XTtcPs_GetCounterValue(&xTimerInstance);
+			now = (last & 0xFFFFFFFF00000000ULL) | low;
+			if (low < (uint32_t)last) {
+				now += 0x100000000ULL;
+			}
+		} while (!__atomic_compare_exchange_n(&timeBaseLast, &last, now, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+		return now;
+	}
+
+	uint32_t PsiFreeRTOS_TimeGetFreqHz() {
+		return timeBaseFreqHz;
+	}
+
+	uint64_t PsiFreeRTOS_TimeToNs(uint64_t time) {
+		return (time / timeBaseFreqHz) * 1000000000ULL + ((time % timeBaseFreqHz) * 1000000000ULL) / timeBaseFreqHz;
+	}
+
+	uint64_t PsiFreeRTOS_TimeToUs(uint64_t time) {
+		return (time / timeBaseFreqHz) * 1000000ULL + ((time % timeBaseFreqHz) * 1000000ULL) / timeBaseFreqHz;
+	}
+
+	uint64_t PsiFreeRTOS_TimeFromUs(uint64_t us) {
+		return (us / 1000000ULL) * timeBaseFreqHz + ((us % 1000000ULL) * timeBaseFreqHz) / 1000000ULL;
+	}
+#endif
+
+#if (configPSI_USE_TICK_STATS == 1)
+	void PsiFreeRTOS_GetTickStats(PsiFreeRTOS_TickStats* stats_p) {
+		taskENTER_CRITICAL();
+		*stats_p = tickStats;
+		const uint64_t sum = tickLatenessSumNs;
+		taskEXIT_CRITICAL();
+		stats_p->latenessAvgNs = (0 == stats_p->ticks) ? 0 : (uint32_t)(sum / stats_p->ticks);
+	}
+
+	void PsiFreeRTOS_ResetTickStats() {
+		taskENTER_CRITICAL();
+		memset(&tickStats, 0, sizeof(tickStats));
+		tickLatenessSumNs = 0;
+		taskEXIT_CRITICAL();
+	}
+
+	void PsiFreeRTOS_PrintTickStats() {
+		PsiFreeRTOS_TickStats stats;
+		PsiFreeRTOS_GetTickStats(&stats);
+		PsiFreeRTOS_printf("PsiFreeRTOS Tick Statistics%s:\r\n", coreName);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Ticks", stats.ticks);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Lateness Avg [ns]", stats.latenessAvgNs);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Lateness Max [ns]", stats.latenessMaxNs);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Lost Ticks", stats.lostTicks);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Pended Ticks", stats.pendedTicks);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Pended Ticks Max", stats.pendedTicksMax);
+		PsiFreeRTOS_printf("Lateness Histogram [ns]:\r\n");
+		for (uint32_t i = 0; i < configPSI_TICK_STATS_BINS; i++) {
+			if (i < configPSI_TICK_STATS_BINS - 1) {
+				PsiFreeRTOS_printf("%8d - %-8d %d\r\n", i*configPSI_TICK_STATS_BIN_NS, (i+1)*configPSI_TICK_STATS_BIN_NS - 1, stats.histogram[i]);
+			}
+			else {
+				PsiFreeRTOS_printf("%8d -          %d\r\n", i*configPSI_TICK_STATS_BIN_NS, stats.histogram[i]);
+			}
+		}
+	}
+#endif
+
+#if (configPSI_USE_EDF == 1)
+	void PsiFreeRTOS_SetDeadlineMissHandler(PsiFreeRTOS_DeadlineMissHandler handler_p) {
+		deadlineMissHandler_p = handler_p;
+	}
+
+	uint32_t PsiFreeRTOS_GetDeadlineMisses() {
+		return edfDeadlineMisses;
+	}
+
+	void PsiFreeRTOS_PrintEdf() {
+		PsiFreeRTOS_printf("PsiFreeRTOS EDF Tasks%s:\r\n", coreName);
+		PsiFreeRTOS_printf("%-20s %-10s %s\r\n", "Task", "Period", "Misses");
+		taskENTER_CRITICAL();
+		for (uint16_t i = 0; i < taskCount; i++) {
+			const TaskHandle_t hndl = allTasks[i];
+			taskEXIT_CRITICAL();
+			//Only periodic tasks are listed
+			const TickType_t period = xTaskEdfGetPeriod(hndl);
+			if (0 != period) {
+				PsiFreeRTOS_printf("%-20s %-10d %d\r\n", pcTaskGetName(hndl), period, uxTaskEdfGetDeadlineMisses(hndl));
+			}
+			taskENTER_CRITICAL();
+		}
+		taskEXIT_CRITICAL();
+		PsiFreeRTOS_printf("%-20s %-10s %d\r\n", "<Total>", "", edfDeadlineMisses);
+	}
+#endif
+
+#if (configPSI_USE_RESERVATION == 1)
+	bool PsiFreeRTOS_SetReservation(TaskHandle_t task_p, uint32_t periodMs, uint32_t budgetUs, bool demote) {
+		const uint64_t budget = PsiFreeRTOS_TimeFromUs(budgetUs);
+		configASSERT(0 != PsiFreeRTOS_TimeGetFreqHz());
+		configASSERT(budget <= UINT32_MAX);
+		return pdPASS == xTaskSetReservation(task_p, pdMS_TO_TICKS(periodMs), (uint32_t)budget,
+											 demote ? eReservationDemote : eReservationSuspend);
+	}
+
+	void PsiFreeRTOS_PrintReservations() {
+		PsiFreeRTOS_printf("PsiFreeRTOS Reservations%s:\r\n", coreName);
+		PsiFreeRTOS_printf("%-20s %-10s %-12s %-12s %s\r\n", "Task", "Period", "Budget [us]", "Used [us]", "Exhausted");
+		taskENTER_CRITICAL();
+		for (uint16_t i = 0; i < taskCount; i++) {
+			const TaskHandle_t hndl = allTasks[i];
+			taskEXIT_CRITICAL();
+			//Only tasks with a reservation are listed
+			const TickType_t period = xTaskGetReservationPeriod(hndl);
+			if (0 != period) {
+				PsiFreeRTOS_printf("%-20s %-10d %-12d %-12d %d\r\n", pcTaskGetName(hndl), period,
+								   (uint32_t)PsiFreeRTOS_TimeToUs(ulTaskGetReservationBudget(hndl)),
+								   (uint32_t)PsiFreeRTOS_TimeToUs(ulTaskGetReservationConsumed(hndl)),
+								   uxTaskGetReservationDepletions(hndl));
+			}
+			taskENTER_CRITICAL();
+		}
+		taskEXIT_CRITICAL();
+	}
+#endif
+
+#if (configPSI_USE_TASK_POOL == 1)
+	void PsiFreeRTOS_PrintTaskPool() {
+		PsiFreeRTOS_printf("PsiFreeRTOS Task Pool%s:\r\n", coreName);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Slots", configPSI_TASK_POOL_SIZE);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Stack [words]", configPSI_TASK_POOL_STACK_DEPTH);
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Used", configPSI_TASK_POOL_SIZE - uxTaskPoolGetFreeSlots());
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Used Max", configPSI_TASK_POOL_SIZE - uxTaskPoolGetMinimumEverFreeSlots());
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Failures", uxTaskPoolGetFailures());
+	}
+#endif
+
+#if (configPSI_USE_PREEMPTION_THRESHOLD == 1)
+	#if (INCLUDE_uxTaskPriorityGet != 1)
+		#error INCLUDE_uxTaskPriorityGet must be 1 when configPSI_USE_PREEMPTION_THRESHOLD is 1
+	#endif
+
+	//Check if a task of priority prioB can preempt the running task a (same rule as the scheduler)
+	static bool ThresholdCanPreempt(const UBaseType_t prioA, const UBaseType_t limitA, const UBaseType_t prioB) {
+		if (prioB > limitA) {
+			return true;
+		}
+		//Equal priorities are time sliced unless a threshold is active
+		return (configUSE_TIME_SLICING == 1) && (prioB == prioA) && (limitA == prioA);
+	}
+
+	void PsiFreeRTOS_PrintPreemptionThresholds() {
+		//Static to not load the stack of the calling task
+		static TaskHandle_t tasks[configPSI_MAX_TASKS];
+		static UBaseType_t prio[configPSI_MAX_TASKS];
+		static UBaseType_t limit[configPSI_MAX_TASKS];
+		taskENTER_CRITICAL();
+		const uint16_t count = taskCount;
+		for (uint16_t i = 0; i < count; i++) {
+			tasks[i] = allTasks[i];
+		}
+		taskEXIT_CRITICAL();
+		for (uint16_t i = 0; i < count; i++) {
+			prio[i] = uxTaskPriorityGet(tasks[i]);
+			limit[i] = uxTaskGetPreemptionThreshold(tasks[i]);
+		}
+		PsiFreeRTOS_printf("PsiFreeRTOS Preemption Thresholds%s:\r\n", coreName);
+		PsiFreeRTOS_printf("%-20s %-6s %-10s %s\r\n", "Task", "Prio", "Threshold", "Non-preemptive with");
+		uint32_t pairs = 0;
+		for (uint16_t i = 0; i < count; i++) {
+			//Tasks that can neither preempt this task nor be preempted by it
+			uint32_t mutual = 0;
+			for (uint16_t j = 0; j < count; j++) {
+				if ((j != i) && !ThresholdCanPreempt(prio[i], limit[i], prio[j]) && !ThresholdCanPreempt(prio[j], limit[j], prio[i])) {
+					mutual++;
+				}
+			}
+			pairs += mutual;
+			PsiFreeRTOS_printf("%-20s %-6d %-10d %d\r\n", pcTaskGetName(tasks[i]), prio[i], limit[i], mutual);
+		}
+		PsiFreeRTOS_printf("%-20s %d\r\n", "Non-preemptive pairs", pairs/2);
+	}
+#endif
+
 void PsiFreeRTOS_PrintHeap() {
-	printfInt("PsiFreeRTOS FreeHeap [bytes]:%d\r\n", remainingHeap);
+	printfInt("PsiFreeRTOS FreeHeap%s [bytes]:%d\r\n", coreName, remainingHeap);
 }
 
 unsigned long PsiFreeRTOS_GetHeap() {
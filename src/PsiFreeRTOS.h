@@ -25,7 +25,8 @@ typedef enum {
 	PsiFreeRTOS_FatalReason_StackOvervflow = 1,
 	PsiFreeRTOS_FatalReason_MallocFailed = 2,
 	PsiFreeRTOS_FatalReason_InfiniteLoop = 3,
-	PsiFreeRTOS_FatalReason_CreatedTooManyTasks = 4
+	PsiFreeRTOS_FatalReason_CreatedTooManyTasks = 4,
+	PsiFreeRTOS_FatalReason_DataAbort = 5
 } PsiFreeRTOS_FatalReason;
 
 /**
@@ -42,6 +43,17 @@ typedef void (*PsiFreeRTOS_FatalHandler)(const PsiFreeRTOS_FatalReason reason);
  */
 typedef void (*PsiFreeRTOS_TickHandler)(void);
 
+#if (configPSI_USE_EDF == 1)
+	/**
+	 * @brief	User code to be executed when a periodic EDF task completes a period after its deadline.
+	 * 			The handler is called in the context of the late task.
+	 *
+	 * @param 	task_p		Task that missed its deadline
+	 * @param	lateness	Ticks from the deadline to the completion of the period
+	 */
+	typedef void (*PsiFreeRTOS_DeadlineMissHandler)(TaskHandle_t task_p, TickType_t lateness);
+#endif
+
 /*******************************************************************************************
  * Macros for thread-safe printing
  *******************************************************************************************/
@@ -128,6 +140,144 @@ void PsiFreeRTOS_Init(	PsiFreeRTOS_FatalHandler fatalHandler_p,
 	uint8_t PsiFreeRTOS_GetCpuLoad(TaskHandle_t task_p);
 #endif
 
+#if (configGENERATE_RUN_TIME_STATS)
+	/**
+	 * @brief	Get the PsiFreeRTOS time base. The time base is the 64-bit extension of the runtime statistics
+	 * 			timer, it is monotonic and does not wrap. The function is lock-free and can be called from tasks
+	 * 			and interrupts. Before the scheduler is started, zero is returned.
+	 *
+	 * @return	Time in timer counts since the scheduler was started
+	 */
+	uint64_t PsiFreeRTOS_TimeGet();
+
+	/**
+	 * @brief	Get the frequency of the time base
+	 *
+	 * @return	Timer counts per second
+	 */
+	uint32_t PsiFreeRTOS_TimeGetFreqHz();
+
+	/**
+	 * @brief	Convert a time base value into nanoseconds
+	 *
+	 * @param 	time	Time in timer counts
+	 * @return			Time in nanoseconds
+	 */
+	uint64_t PsiFreeRTOS_TimeToNs(uint64_t time);
+
+	/**
+	 * @brief	Convert a time base value into microseconds
+	 *
+	 * @param 	time	Time in timer counts
+	 * @return			Time in microseconds
+	 */
+	uint64_t PsiFreeRTOS_TimeToUs(uint64_t time);
+
+	/**
+	 * @brief	Convert microseconds into time base counts
+	 *
+	 * @param 	us		Time in microseconds
+	 * @return			Time in timer counts
+	 */
+	uint64_t PsiFreeRTOS_TimeFromUs(uint64_t us);
+#endif
+
+#if (configPSI_USE_TICK_STATS == 1)
+	/**
+	 * @brief	Statistics of the tick interrupt
+	 */
+	typedef struct {
+		uint32_t ticks;				//Number of ticks measured
+		uint32_t latenessAvgNs;		//Average time from the tick timer interval boundary to the tick handler
+		uint32_t latenessMaxNs;		//Maximum time from the tick timer interval boundary to the tick handler
+		uint32_t lostTicks;			//Ticks lost because the tick interrupt was delayed by more than one period
+		uint32_t pendedTicks;		//Ticks that occurred while the scheduler was suspended
+		uint32_t pendedTicksMax;	//Maximum number of ticks pending at the same time
+		uint32_t histogram[configPSI_TICK_STATS_BINS];	//Lateness histogram (bins of configPSI_TICK_STATS_BIN_NS,
+														//..the last bin contains all larger values)
+	} PsiFreeRTOS_TickStats;
+
+	/**
+	 * @brief	Get the statistics of the tick interrupt (since startup or since the last call
+	 * 			to PsiFreeRTOS_ResetTickStats())
+	 *
+	 * @param	stats_p		Statistics output
+	 */
+	void PsiFreeRTOS_GetTickStats(PsiFreeRTOS_TickStats* stats_p);
+
+	/**
+	 * @brief	Restart the tick interrupt statistics
+	 */
+	void PsiFreeRTOS_ResetTickStats();
+
+	/**
+	 * @brief	Print the statistics of the tick interrupt to the console
+	 */
+	void PsiFreeRTOS_PrintTickStats();
+#endif
+
+#if (configPSI_USE_EDF == 1)
+	/**
+	 * @brief	Register a handler for deadline misses of EDF tasks. By default (handler NULL) a warning
+	 * 			is printed to the console.
+	 *
+	 * @param	handler_p	Handler function or NULL
+	 */
+	void PsiFreeRTOS_SetDeadlineMissHandler(PsiFreeRTOS_DeadlineMissHandler handler_p);
+
+	/**
+	 * @brief	Get the number of deadline misses of all EDF tasks since startup
+	 *
+	 * @return	Number of periods completed after their deadline
+	 */
+	uint32_t PsiFreeRTOS_GetDeadlineMisses();
+
+	/**
+	 * @brief	Print the period and the number of deadline misses of all periodic tasks to the console
+	 */
+	void PsiFreeRTOS_PrintEdf();
+#endif
+
+#if (configPSI_USE_RESERVATION == 1)
+	/**
+	 * @brief	Limit the execution time of a task to a budget per period. When the budget is exhausted,
+	 * 			the task is suspended or demoted to configPSI_RESERVATION_DEMOTE_PRIORITY until the next
+	 * 			period starts. Must be called after the scheduler is started (the budget is converted
+	 * 			to time base counts).
+	 *
+	 * @param	task_p		Task to limit
+	 * @param	periodMs	Replenishment period in ms (0 removes the reservation)
+	 * @param	budgetUs	Execution time per period in us
+	 * @param	demote		True = demote the task on exhaustion, false = suspend it
+	 * @return				True on success, false if configPSI_RESERVATION_MAX_TASKS is exceeded
+	 */
+	bool PsiFreeRTOS_SetReservation(TaskHandle_t task_p, uint32_t periodMs, uint32_t budgetUs, bool demote);
+
+	/**
+	 * @brief	Print the period, budget, consumption and number of exhausted periods of all tasks with
+	 * 			a reservation to the console
+	 */
+	void PsiFreeRTOS_PrintReservations();
+#endif
+
+#if (configPSI_USE_TASK_POOL == 1)
+	/**
+	 * @brief	Print the usage of the task pool (xTaskCreateFromPool()) to the console: slots in use,
+	 * 			maximum slots in use since startup and number of failed creations
+	 */
+	void PsiFreeRTOS_PrintTaskPool();
+#endif
+
+#if (configPSI_USE_PREEMPTION_THRESHOLD == 1)
+	/**
+	 * @brief	Print priority and effective preemption threshold of all tasks to the console. For
+	 * 			each task, the number of tasks it can neither preempt nor be preempted by is listed.
+	 * 			Such tasks never interrupt each other, if they do not block in the middle of their
+	 * 			work they could share one stack.
+	 */
+	void PsiFreeRTOS_PrintPreemptionThresholds();
+#endif
+
 /**
 * @brief Print remaining heap memory to the console. Note that this does not say anything about fragmentation
 *        but only about the number of bytes available.
@@ -0,0 +1,686 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_Bench.h"
+#include "PsiFreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "xscugic.h"
+
+#if (configPSI_USE_BENCHMARK == 1)
+
+#if (INCLUDE_vTaskPrioritySet != 1) || (INCLUDE_vTaskDelete != 1)
+	#error The PsiFreeRTOS benchmark requires INCLUDE_vTaskPrioritySet and INCLUDE_vTaskDelete
+#endif
+
+#if (configPSI_BENCH_SGI_ID > 15)
+	#error configPSI_BENCH_SGI_ID must be a software generated interrupt (0 ... 15)
+#endif
+
+//Event groups are set from interrupts through the timer daemon task
+#if (configUSE_TIMERS == 1) && (INCLUDE_xTimerPendFunctionCall == 1)
+	#define BENCH_EVENT_GROUP_AVAILABLE
+#endif
+
+/*******************************************************************************************
+ * Private Constants
+ *******************************************************************************************/
+#define BENCH_PRIORITY				(configMAX_PRIORITIES - 1)
+#define BENCH_HELPER_STACK			configMINIMAL_STACK_SIZE
+//Gaps in the cycle counter above this value are interrupts (a loop iteration takes far less)
+#define BENCH_GAP_THRESHOLD_CYCLES	100
+//Interrupts triggered per tick, lower priority tasks (and the idle task) run for the rest of the tick
+#define BENCH_LATENCY_TICK_SAMPLES	10
+//The tick benchmark spins in chunks, the idle task runs in between (infinite loop detection)
+#define BENCH_TICK_CHUNK			((configPSI_MAX_TICKS_WITHOUT_IDLE > 2) ? (configPSI_MAX_TICKS_WITHOUT_IDLE / 2) : 1)
+//Timeout of the delayed task benchmark (later than all sleeping tasks wake up)
+#define BENCH_DELAYED_TIMEOUT		30000
+//Notifications sent per iteration of the preemption threshold benchmark
+#define BENCH_THRESHOLD_BURST		4
+
+/*******************************************************************************************
+ * Private Variables
+ *******************************************************************************************/
+static volatile bool benchStop;
+static volatile PsiFreeRTOS_BenchWake latWake;
+static volatile uint32_t latIrqCycles;
+static SemaphoreHandle_t latDone;
+static PsiFreeRTOS_BenchHist* latTask_p;
+static TaskHandle_t latWaiter;
+static QueueHandle_t latQueue;
+static SemaphoreHandle_t latSemaphore;
+#ifdef BENCH_EVENT_GROUP_AVAILABLE
+	static EventGroupHandle_t latEvents;
+#endif
+//Index 0 is received by the measuring task, index 1 by the partner task
+static PsiFreeRTOS_BenchWake pingWake;
+static QueueHandle_t pingQueue[2];
+static SemaphoreHandle_t pingSemaphore[2];
+static TaskHandle_t pingTask[2];
+static SemaphoreHandle_t mutexBench;
+static TaskHandle_t mutexTask;
+static TaskHandle_t delayedTask[2];
+static TaskHandle_t thresholdTask[2];
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+static void BenchYieldPartner(void* arg_p) {
+	while (!benchStop) {
+		taskYIELD();
+	}
+	vTaskDelete(NULL);
+}
+
+static void BenchPingGive(const uint32_t dst) {
+	const uint32_t item = 0;
+	switch (pingWake) {
+		case PsiFreeRTOS_BenchWake_Queue:
+			xQueueSend(pingQueue[dst], &item, portMAX_DELAY);
+			break;
+		case PsiFreeRTOS_BenchWake_Semaphore:
+			xSemaphoreGive(pingSemaphore[dst]);
+			break;
+		case PsiFreeRTOS_BenchWake_Notification:
+			xTaskNotifyGive(pingTask[dst]);
+			break;
+		default:
+			break;
+	}
+}
+
+static void BenchPingTake(const uint32_t self) {
+	uint32_t item;
+	switch (pingWake) {
+		case PsiFreeRTOS_BenchWake_Queue:
+			xQueueReceive(pingQueue[self], &item, portMAX_DELAY);
+			break;
+		case PsiFreeRTOS_BenchWake_Semaphore:
+			xSemaphoreTake(pingSemaphore[self], portMAX_DELAY);
+			break;
+		case PsiFreeRTOS_BenchWake_Notification:
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			break;
+		default:
+			break;
+	}
+}
+
+static void BenchPingPongPartner(void* arg_p) {
+	for (;;) {
+		BenchPingTake(1);
+		if (benchStop) {
+			break;
+		}
+		BenchPingGive(0);
+	}
+	vTaskDelete(NULL);
+}
+
+static void BenchLatencyIsr(void* arg_p) {
+	const uint32_t now = PsiFreeRTOS_PmuCycles();
+	BaseType_t higherPrioWoken = pdFALSE;
+	latIrqCycles = now;
+	switch (latWake) {
+		case PsiFreeRTOS_BenchWake_Resume:
+			higherPrioWoken = xTaskResumeFromISR(latWaiter);
+			break;
+		case PsiFreeRTOS_BenchWake_Queue:
+			xQueueSendFromISR(latQueue, &now, &higherPrioWoken);
+			break;
+		case PsiFreeRTOS_BenchWake_Semaphore:
+			xSemaphoreGiveFromISR(latSemaphore, &higherPrioWoken);
+			break;
+		case PsiFreeRTOS_BenchWake_Notification:
+			vTaskNotifyGiveFromISR(latWaiter, &higherPrioWoken);
+			break;
+		#ifdef BENCH_EVENT_GROUP_AVAILABLE
+		case PsiFreeRTOS_BenchWake_EventGroup:
+			xEventGroupSetBitsFromISR(latEvents, 1, &higherPrioWoken);
+			break;
+		#endif
+		default:
+			break;
+	}
+	portYIELD_FROM_ISR(higherPrioWoken);
+}
+
+static void BenchLatencyWaiter(void* arg_p) {
+	for (;;) {
+		uint32_t item;
+		switch (latWake) {
+			case PsiFreeRTOS_BenchWake_Resume:
+				vTaskSuspend(NULL);
+				break;
+			case PsiFreeRTOS_BenchWake_Queue:
+				xQueueReceive(latQueue, &item, portMAX_DELAY);
+				break;
+			case PsiFreeRTOS_BenchWake_Semaphore:
+				xSemaphoreTake(latSemaphore, portMAX_DELAY);
+				break;
+			case PsiFreeRTOS_BenchWake_Notification:
+				ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+				break;
+			#ifdef BENCH_EVENT_GROUP_AVAILABLE
+			case PsiFreeRTOS_BenchWake_EventGroup:
+				xEventGroupWaitBits(latEvents, 1, pdTRUE, pdFALSE, portMAX_DELAY);
+				break;
+			#endif
+			default:
+				break;
+		}
+		const uint32_t now = PsiFreeRTOS_PmuCycles();
+		if (benchStop) {
+			break;
+		}
+		PsiFreeRTOS_BenchHistAdd(latTask_p, now - latIrqCycles);
+		xSemaphoreGive(latDone);
+	}
+	//Signal that the kernel objects are no longer used
+	xSemaphoreGive(latDone);
+	vTaskDelete(NULL);
+}
+
+static void BenchMutexPartner(void* arg_p) {
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		if (benchStop) {
+			break;
+		}
+		xSemaphoreTake(mutexBench, portMAX_DELAY);
+		xSemaphoreGive(mutexBench);
+	}
+	vTaskDelete(NULL);
+}
+
+//Sleeping tasks only fill the delayed lists, the delay is passed as argument
+static void BenchSleeper(void* arg_p) {
+	for (;;) {
+		vTaskDelay((TickType_t)(uintptr_t)arg_p);
+	}
+}
+
+static void BenchDelayedPartner(void* arg_p) {
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, BENCH_DELAYED_TIMEOUT);
+		if (benchStop) {
+			break;
+		}
+		xTaskNotifyGive(delayedTask[0]);
+	}
+	vTaskDelete(NULL);
+}
+
+//Acknowledges each burst of notifications to the sending task
+static void BenchThresholdPartner(void* arg_p) {
+	uint32_t received = 0;
+	for (;;) {
+		received += ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		if (benchStop) {
+			break;
+		}
+		if (received >= BENCH_THRESHOLD_BURST) {
+			received = 0;
+			xTaskNotifyGive(thresholdTask[0]);
+		}
+	}
+	vTaskDelete(NULL);
+}
+
+//Print a fixed point value with two decimals
+static void BenchPrintRatio(const char* name, uint32_t num, uint32_t den) {
+	const uint32_t ratio = (0 == den) ? 0 : (uint32_t)(((uint64_t)num * 100) / den);
+	PsiFreeRTOS_printf("%-24s %d.%02d\r\n", name, ratio / 100, ratio % 100);
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+void PsiFreeRTOS_BenchStatReset(PsiFreeRTOS_BenchStat* stat_p, const char* name) {
+	stat_p->name = name;
+	stat_p->min = UINT32_MAX;
+	stat_p->max = 0;
+	stat_p->sum = 0;
+	stat_p->count = 0;
+}
+
+void PsiFreeRTOS_BenchStatAdd(PsiFreeRTOS_BenchStat* stat_p, uint32_t cycles) {
+	if (cycles < stat_p->min) {
+		stat_p->min = cycles;
+	}
+	if (cycles > stat_p->max) {
+		stat_p->max = cycles;
+	}
+	stat_p->sum += cycles;
+	stat_p->count++;
+}
+
+void PsiFreeRTOS_BenchHistReset(PsiFreeRTOS_BenchHist* hist_p, const char* name, uint32_t binCycles) {
+	PsiFreeRTOS_BenchStatReset(&hist_p->stat, name);
+	hist_p->binCycles = binCycles;
+	for (uint32_t i = 0; i < configPSI_BENCH_HIST_BINS; i++) {
+		hist_p->bins[i] = 0;
+	}
+}
+
+void PsiFreeRTOS_BenchHistAdd(PsiFreeRTOS_BenchHist* hist_p, uint32_t cycles) {
+	uint32_t bin = cycles / hist_p->binCycles;
+	if (bin >= configPSI_BENCH_HIST_BINS) {
+		bin = configPSI_BENCH_HIST_BINS - 1;
+	}
+	hist_p->bins[bin]++;
+	PsiFreeRTOS_BenchStatAdd(&hist_p->stat, cycles);
+}
+
+uint32_t PsiFreeRTOS_BenchHistPercentile(const PsiFreeRTOS_BenchHist* hist_p, uint16_t permille) {
+	const uint64_t limit = ((uint64_t)hist_p->stat.count * permille + 999) / 1000;
+	uint64_t sum = 0;
+	for (uint32_t i = 0; i < configPSI_BENCH_HIST_BINS - 1; i++) {
+		sum += hist_p->bins[i];
+		if (sum >= limit) {
+			const uint32_t upper = (i + 1) * hist_p->binCycles - 1;
+			return (upper < hist_p->stat.max) ? upper : hist_p->stat.max;
+		}
+	}
+	return hist_p->stat.max;
+}
+
+void PsiFreeRTOS_BenchYield(uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p) {
+	const UBaseType_t oldPrio = uxTaskPriorityGet(NULL);
+	vTaskPrioritySet(NULL, BENCH_PRIORITY);
+	benchStop = false;
+	xTaskCreate(BenchYieldPartner, "BenchYield", BENCH_HELPER_STACK, NULL, BENCH_PRIORITY, NULL);
+	//Let the partner task run once before measuring
+	taskYIELD();
+	for (uint32_t i = 0; i < iterations; i++) {
+		const uint32_t start = PsiFreeRTOS_PmuCycles();
+		taskYIELD();
+		PsiFreeRTOS_BenchStatAdd(stat_p, PsiFreeRTOS_PmuCycles() - start);
+	}
+	benchStop = true;
+	taskYIELD();
+	vTaskPrioritySet(NULL, oldPrio);
+}
+
+void PsiFreeRTOS_BenchPingPong(PsiFreeRTOS_BenchWake wake, uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p) {
+	configASSERT((PsiFreeRTOS_BenchWake_Queue == wake) || (PsiFreeRTOS_BenchWake_Semaphore == wake) ||
+				 (PsiFreeRTOS_BenchWake_Notification == wake));
+	const UBaseType_t oldPrio = uxTaskPriorityGet(NULL);
+	vTaskPrioritySet(NULL, BENCH_PRIORITY);
+	pingWake = wake;
+	benchStop = false;
+	for (uint32_t i = 0; i < 2; i++) {
+		pingQueue[i] = xQueueCreate(1, sizeof(uint32_t));
+		pingSemaphore[i] = xSemaphoreCreateBinary();
+	}
+	pingTask[0] = xGetCurrentTaskHandle();
+	xTaskCreate(BenchPingPongPartner, "BenchPingPong", BENCH_HELPER_STACK, NULL, BENCH_PRIORITY, &pingTask[1]);
+	//Let the partner task block before measuring
+	taskYIELD();
+	for (uint32_t i = 0; i < iterations; i++) {
+		const uint32_t start = PsiFreeRTOS_PmuCycles();
+		BenchPingGive(1);
+		BenchPingTake(0);
+		PsiFreeRTOS_BenchStatAdd(stat_p, PsiFreeRTOS_PmuCycles() - start);
+	}
+	benchStop = true;
+	BenchPingGive(1);
+	taskYIELD();
+	for (uint32_t i = 0; i < 2; i++) {
+		vQueueDelete(pingQueue[i]);
+		vSemaphoreDelete(pingSemaphore[i]);
+	}
+	vTaskPrioritySet(NULL, oldPrio);
+}
+
+void PsiFreeRTOS_BenchMutex(bool ceiling, uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p, uint32_t* switches_p) {
+	#if (configPSI_USE_CEILING_MUTEX != 1)
+		if (ceiling) {
+			PsiFreeRTOS_printf("In %s: ceiling mutexes require configPSI_USE_CEILING_MUTEX\r\n", __func__);
+			return;
+		}
+	#endif
+	const UBaseType_t oldPrio = uxTaskPriorityGet(NULL);
+	//The partner task preempts the calling task when it is notified
+	vTaskPrioritySet(NULL, BENCH_PRIORITY - 1);
+	benchStop = false;
+	#if (configPSI_USE_CEILING_MUTEX == 1)
+		mutexBench = ceiling ? xSemaphoreCreateMutexWithCeiling(BENCH_PRIORITY) : xSemaphoreCreateMutex();
+	#else
+		mutexBench = xSemaphoreCreateMutex();
+	#endif
+	//The partner task runs immediately and blocks on the notification
+	xTaskCreate(BenchMutexPartner, "BenchMutex", BENCH_HELPER_STACK, NULL, BENCH_PRIORITY, &mutexTask);
+	const uint32_t switchesStart = ulTaskGetSwitchCount();
+	for (uint32_t i = 0; i < iterations; i++) {
+		const uint32_t start = PsiFreeRTOS_PmuCycles();
+		xSemaphoreTake(mutexBench, portMAX_DELAY);
+		xTaskNotifyGive(mutexTask);
+		xSemaphoreGive(mutexBench);
+		PsiFreeRTOS_BenchStatAdd(stat_p, PsiFreeRTOS_PmuCycles() - start);
+	}
+	*switches_p = ulTaskGetSwitchCount() - switchesStart;
+	benchStop = true;
+	xTaskNotifyGive(mutexTask);
+	vSemaphoreDelete(mutexBench);
+	vTaskPrioritySet(NULL, oldPrio);
+}
+
+void PsiFreeRTOS_BenchThreshold(bool threshold, uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p, uint32_t* switches_p) {
+	#if (configPSI_USE_PREEMPTION_THRESHOLD != 1)
+		if (threshold) {
+			PsiFreeRTOS_printf("In %s: thresholds require configPSI_USE_PREEMPTION_THRESHOLD\r\n", __func__);
+			return;
+		}
+	#endif
+	const UBaseType_t oldPrio = uxTaskPriorityGet(NULL);
+	//Without threshold, the partner task preempts the calling task on each notification
+	vTaskPrioritySet(NULL, BENCH_PRIORITY - 1);
+	benchStop = false;
+	thresholdTask[0] = xGetCurrentTaskHandle();
+	//The partner task runs immediately and blocks on the notification
+	xTaskCreate(BenchThresholdPartner, "BenchThreshold", BENCH_HELPER_STACK, NULL, BENCH_PRIORITY, &thresholdTask[1]);
+	#if (configPSI_USE_PREEMPTION_THRESHOLD == 1)
+		if (threshold) {
+			vTaskSetPreemptionThreshold(NULL, BENCH_PRIORITY);
+		}
+	#endif
+	const uint32_t switchesStart = ulTaskGetSwitchCount();
+	for (uint32_t i = 0; i < iterations; i++) {
+		const uint32_t start = PsiFreeRTOS_PmuCycles();
+		for (uint32_t n = 0; n < BENCH_THRESHOLD_BURST; n++) {
+			xTaskNotifyGive(thresholdTask[1]);
+		}
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		PsiFreeRTOS_BenchStatAdd(stat_p, PsiFreeRTOS_PmuCycles() - start);
+	}
+	*switches_p = ulTaskGetSwitchCount() - switchesStart;
+	#if (configPSI_USE_PREEMPTION_THRESHOLD == 1)
+		vTaskSetPreemptionThreshold(NULL, 0);
+	#endif
+	benchStop = true;
+	xTaskNotifyGive(thresholdTask[1]);
+	vTaskPrioritySet(NULL, oldPrio);
+}
+
+void PsiFreeRTOS_BenchTick(uint32_t ticks, PsiFreeRTOS_BenchStat* stat_p) {
+	const UBaseType_t oldPrio = uxTaskPriorityGet(NULL);
+	vTaskPrioritySet(NULL, BENCH_PRIORITY);
+	for (uint32_t measured = 0; measured < ticks; ) {
+		const uint32_t chunk = ((ticks - measured) < BENCH_TICK_CHUNK) ? (ticks - measured) : BENCH_TICK_CHUNK;
+		//Synchronize to a tick
+		const TickType_t startTick = xTaskGetTickCount();
+		while (xTaskGetTickCount() == startTick) {}
+		const TickType_t firstTick = xTaskGetTickCount();
+		uint32_t last = PsiFreeRTOS_PmuCycles();
+		while ((xTaskGetTickCount() - firstTick) < chunk) {
+			const uint32_t now = PsiFreeRTOS_PmuCycles();
+			if ((now - last) > BENCH_GAP_THRESHOLD_CYCLES) {
+				PsiFreeRTOS_BenchStatAdd(stat_p, now - last);
+			}
+			last = now;
+		}
+		measured += chunk;
+		//Let the idle task run before the next chunk
+		vTaskDelay(1);
+	}
+	vTaskPrioritySet(NULL, oldPrio);
+}
+
+bool PsiFreeRTOS_BenchDelayed(uint32_t tasks, uint32_t iterations, PsiFreeRTOS_BenchStat* block_p, PsiFreeRTOS_BenchStat* tick_p) {
+	TaskHandle_t* sleepers_p = NULL;
+	uint32_t created = 0;
+	bool ok = true;
+	if (tasks > 0) {
+		sleepers_p = pvPortMalloc(tasks*sizeof(TaskHandle_t));
+		if (NULL == sleepers_p) {
+			PsiFreeRTOS_printf("In %s: allocation failed\r\n", __func__);
+			return false;
+		}
+	}
+	//Wake times are spread, so tasks are inserted all over the sorted delayed list
+	for (; created < tasks; created++) {
+		const TickType_t delay = 10000 + (created*7919) % 10000;
+		if (pdPASS != xTaskCreate(BenchSleeper, "BenchSleep", BENCH_HELPER_STACK, (void*)(uintptr_t)delay,
+								  tskIDLE_PRIORITY + 1, &sleepers_p[created])) {
+			PsiFreeRTOS_printf("In %s: creating sleeping task %d of %d failed (check configPSI_MAX_TASKS and the heap)\r\n",
+							   __func__, created + 1, tasks);
+			ok = false;
+			break;
+		}
+	}
+	if (ok) {
+		//Let the sleeping tasks block
+		vTaskDelay(2);
+		const UBaseType_t oldPrio = uxTaskPriorityGet(NULL);
+		vTaskPrioritySet(NULL, BENCH_PRIORITY);
+		benchStop = false;
+		delayedTask[0] = xGetCurrentTaskHandle();
+		if (pdPASS != xTaskCreate(BenchDelayedPartner, "BenchDelayed", BENCH_HELPER_STACK, NULL, BENCH_PRIORITY, &delayedTask[1])) {
+			PsiFreeRTOS_printf("In %s: creating partner task failed\r\n", __func__);
+			ok = false;
+		}
+		else {
+			//Let the partner task block before measuring
+			taskYIELD();
+			for (uint32_t i = 0; i < iterations; i++) {
+				const uint32_t start = PsiFreeRTOS_PmuCycles();
+				xTaskNotifyGive(delayedTask[1]);
+				ulTaskNotifyTake(pdTRUE, BENCH_DELAYED_TIMEOUT);
+				PsiFreeRTOS_BenchStatAdd(block_p, PsiFreeRTOS_PmuCycles() - start);
+			}
+			benchStop = true;
+			xTaskNotifyGive(delayedTask[1]);
+			taskYIELD();
+			PsiFreeRTOS_BenchTick(1000, tick_p);
+		}
+		vTaskPrioritySet(NULL, oldPrio);
+	}
+	//Only the tasks actually created are deleted
+	for (uint32_t i = 0; i < created; i++) {
+		vTaskDelete(sleepers_p[i]);
+	}
+	vPortFree(sleepers_p);
+	return ok;
+}
+
+void PsiFreeRTOS_BenchDelayedSweep(uint32_t maxTasks, uint32_t iterations) {
+	configASSERT(iterations > 0);
+	PsiFreeRTOS_printf("PsiFreeRTOS Delayed Tasks Benchmark [CPU cycles]:\r\n");
+	PsiFreeRTOS_printf("%8s %12s %12s %12s %12s\r\n", "Tasks", "RoundTrip", "RoundTrip", "TickISR", "TickISR");
+	PsiFreeRTOS_printf("%8s %12s %12s %12s %12s\r\n", "", "Avg", "Max", "Avg", "Max");
+	//0, 1, 2, 4, ... and maxTasks as last point
+	uint32_t tasks = 0;
+	for (;;) {
+		PsiFreeRTOS_BenchStat block, tick;
+		PsiFreeRTOS_BenchStatReset(&block, "Timeout ping-pong");
+		PsiFreeRTOS_BenchStatReset(&tick, "Tick ISR (delayed)");
+		if (!PsiFreeRTOS_BenchDelayed(tasks, iterations, &block, &tick)) {
+			PsiFreeRTOS_printf("Aborted at %d tasks\r\n", tasks);
+			return;
+		}
+		PsiFreeRTOS_printf("%8d %12d %12d %12d %12d\r\n", tasks,
+						   (uint32_t)(block.sum / block.count), block.max,
+						   (uint32_t)(tick.sum / tick.count), tick.max);
+		if (tasks >= maxTasks) {
+			break;
+		}
+		tasks = (0 == tasks) ? 1 : tasks*2;
+		if (tasks > maxTasks) {
+			tasks = maxTasks;
+		}
+	}
+}
+
+void PsiFreeRTOS_BenchIrqLatency(PsiFreeRTOS_BenchWake wake, uint32_t samples,
+								 PsiFreeRTOS_BenchHist* entry_p, PsiFreeRTOS_BenchHist* task_p) {
+	#ifndef BENCH_EVENT_GROUP_AVAILABLE
+		if (PsiFreeRTOS_BenchWake_EventGroup == wake) {
+			PsiFreeRTOS_printf("In %s: event groups require configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall\r\n", __func__);
+			return;
+		}
+	#endif
+	XScuGic* gic_p = PsiFreeRTOS_GetXScuGic();
+	const UBaseType_t oldPrio = uxTaskPriorityGet(NULL);
+	//The woken task must preempt the triggering task
+	vTaskPrioritySet(NULL, BENCH_PRIORITY - 1);
+	latWake = wake;
+	latTask_p = task_p;
+	benchStop = false;
+	latQueue = xQueueCreate(1, sizeof(uint32_t));
+	latSemaphore = xSemaphoreCreateBinary();
+	latDone = xSemaphoreCreateBinary();
+	#ifdef BENCH_EVENT_GROUP_AVAILABLE
+		latEvents = xEventGroupCreate();
+	#endif
+	xTaskCreate(BenchLatencyWaiter, "BenchLatency", BENCH_HELPER_STACK, NULL, BENCH_PRIORITY, &latWaiter);
+
+	//Install interrupt with the lowest priority allowed to call the FreeRTOS API (keep trigger type)
+	uint8_t prio, trigger;
+	xPortInstallInterruptHandler(configPSI_BENCH_SGI_ID, BenchLatencyIsr, NULL);
+	XScuGic_GetPriorityTriggerType(gic_p, configPSI_BENCH_SGI_ID, &prio, &trigger);
+	XScuGic_SetPriorityTriggerType(gic_p, configPSI_BENCH_SGI_ID,
+								   configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT, trigger);
+	vPortEnableInterrupt(configPSI_BENCH_SGI_ID);
+
+	for (uint32_t i = 0; i < samples; i++) {
+		const uint32_t start = PsiFreeRTOS_PmuCycles();
+		XScuGic_SoftwareIntr(gic_p, configPSI_BENCH_SGI_ID, 1UL << ulPortGetCoreID());
+		//Block until the woken task has recorded the sample
+		xSemaphoreTake(latDone, portMAX_DELAY);
+		if (NULL != entry_p) {
+			PsiFreeRTOS_BenchHistAdd(entry_p, latIrqCycles - start);
+		}
+		//Block for the rest of the tick, so the background load runs between the samples
+		if (0 == ((i + 1) % BENCH_LATENCY_TICK_SAMPLES)) {
+			vTaskDelay(1);
+		}
+	}
+
+	//Release the waiting task once more to let it terminate
+	benchStop = true;
+	XScuGic_SoftwareIntr(gic_p, configPSI_BENCH_SGI_ID, 1UL << ulPortGetCoreID());
+	//Event groups are set through the timer daemon task, which may have a lower priority, so
+	//..the objects are deleted only after the waiting task has exited
+	xSemaphoreTake(latDone, portMAX_DELAY);
+	vPortDisableInterrupt(configPSI_BENCH_SGI_ID);
+	vQueueDelete(latQueue);
+	vSemaphoreDelete(latSemaphore);
+	vSemaphoreDelete(latDone);
+	#ifdef BENCH_EVENT_GROUP_AVAILABLE
+		vEventGroupDelete(latEvents);
+	#endif
+	vTaskPrioritySet(NULL, oldPrio);
+}
+
+void PsiFreeRTOS_BenchPrint(const PsiFreeRTOS_BenchStat* stats_p, uint16_t count) {
+	PsiFreeRTOS_printf("PsiFreeRTOS Benchmark [CPU cycles]:\r\n");
+	PsiFreeRTOS_printf("%-24s %8s %8s %8s %8s\r\n", "Name", "Min", "Avg", "Max", "Count");
+	for (uint16_t i = 0; i < count; i++) {
+		const PsiFreeRTOS_BenchStat* stat_p = &stats_p[i];
+		if (0 == stat_p->count) {
+			PsiFreeRTOS_printf("%-24s %8s %8s %8s %8d\r\n", stat_p->name, "-", "-", "-", 0);
+			continue;
+		}
+		PsiFreeRTOS_printf("%-24s %8d %8d %8d %8d\r\n",
+							stat_p->name,
+							stat_p->min,
+							(uint32_t)(stat_p->sum / stat_p->count),
+							stat_p->max,
+							stat_p->count);
+	}
+}
+
+void PsiFreeRTOS_BenchHistPrint(const PsiFreeRTOS_BenchHist* hists_p, uint16_t count) {
+	PsiFreeRTOS_printf("PsiFreeRTOS Benchmark [CPU cycles]:\r\n");
+	PsiFreeRTOS_printf("%-24s %8s %8s %8s %8s %8s\r\n", "Name", "Min", "Avg", "P99", "Max", "Count");
+	for (uint16_t i = 0; i < count; i++) {
+		const PsiFreeRTOS_BenchStat* stat_p = &hists_p[i].stat;
+		if (0 == stat_p->count) {
+			PsiFreeRTOS_printf("%-24s %8s %8s %8s %8s %8d\r\n", stat_p->name, "-", "-", "-", "-", 0);
+			continue;
+		}
+		PsiFreeRTOS_printf("%-24s %8d %8d %8d %8d %8d\r\n",
+							stat_p->name,
+							stat_p->min,
+							(uint32_t)(stat_p->sum / stat_p->count),
+							PsiFreeRTOS_BenchHistPercentile(&hists_p[i], 990),
+							stat_p->max,
+							stat_p->count);
+	}
+}
+
+void PsiFreeRTOS_BenchPrintConfig() {
+	PsiFreeRTOS_printf("configUSE_TASK_FPU_SUPPORT: %d, configCHECK_FOR_STACK_OVERFLOW: %d, configPSI_USE_MPU_STACK_GUARD: %d\r\n",
+						configUSE_TASK_FPU_SUPPORT, configCHECK_FOR_STACK_OVERFLOW, configPSI_USE_MPU_STACK_GUARD);
+	PsiFreeRTOS_printf("configUSE_TRACE_FACILITY: %d, configGENERATE_RUN_TIME_STATS: %d, configUSE_PORT_OPTIMISED_TASK_SELECTION: %d\r\n",
+						configUSE_TRACE_FACILITY, configGENERATE_RUN_TIME_STATS, configUSE_PORT_OPTIMISED_TASK_SELECTION);
+	PsiFreeRTOS_printf("configPSI_USE_CEILING_MUTEX: %d, configPSI_USE_DELAY_WHEEL: %d, configPSI_USE_PREEMPTION_THRESHOLD: %d\r\n",
+						configPSI_USE_CEILING_MUTEX, configPSI_USE_DELAY_WHEEL, configPSI_USE_PREEMPTION_THRESHOLD);
+}
+
+void PsiFreeRTOS_BenchRun() {
+	PsiFreeRTOS_BenchStat stats[9];
+	uint16_t count = 5;
+	uint32_t inheritSwitches, ceilingSwitches, burstSwitches, thresholdSwitches;
+	PsiFreeRTOS_PmuInit();
+	PsiFreeRTOS_BenchStatReset(&stats[0], "Yield (2 switches)");
+	PsiFreeRTOS_BenchYield(10000, &stats[0]);
+	PsiFreeRTOS_BenchStatReset(&stats[1], "Semaphore ping-pong");
+	PsiFreeRTOS_BenchPingPong(PsiFreeRTOS_BenchWake_Semaphore, 10000, &stats[1]);
+	PsiFreeRTOS_BenchStatReset(&stats[2], "Queue ping-pong");
+	PsiFreeRTOS_BenchPingPong(PsiFreeRTOS_BenchWake_Queue, 10000, &stats[2]);
+	PsiFreeRTOS_BenchStatReset(&stats[3], "Notification ping-pong");
+	PsiFreeRTOS_BenchPingPong(PsiFreeRTOS_BenchWake_Notification, 10000, &stats[3]);
+	PsiFreeRTOS_BenchStatReset(&stats[4], "Tick ISR");
+	PsiFreeRTOS_BenchTick(1000, &stats[4]);
+	PsiFreeRTOS_BenchStatReset(&stats[count], "Mutex (inheritance)");
+	PsiFreeRTOS_BenchMutex(false, 10000, &stats[count++], &inheritSwitches);
+	#if (configPSI_USE_CEILING_MUTEX == 1)
+		PsiFreeRTOS_BenchStatReset(&stats[count], "Mutex (ceiling)");
+		PsiFreeRTOS_BenchMutex(true, 10000, &stats[count++], &ceilingSwitches);
+	#endif
+	PsiFreeRTOS_BenchStatReset(&stats[count], "Notify burst");
+	PsiFreeRTOS_BenchThreshold(false, 10000, &stats[count++], &burstSwitches);
+	#if (configPSI_USE_PREEMPTION_THRESHOLD == 1)
+		PsiFreeRTOS_BenchStatReset(&stats[count], "Notify burst (threshold)");
+		PsiFreeRTOS_BenchThreshold(true, 10000, &stats[count++], &thresholdSwitches);
+	#endif
+	PsiFreeRTOS_BenchPrintConfig();
+	PsiFreeRTOS_BenchPrint(stats, count);
+	PsiFreeRTOS_printf("Context switches per mutex contention:\r\n");
+	BenchPrintRatio("Mutex (inheritance)", inheritSwitches, 10000);
+	#if (configPSI_USE_CEILING_MUTEX == 1)
+		BenchPrintRatio("Mutex (ceiling)", ceilingSwitches, 10000);
+	#endif
+	PsiFreeRTOS_printf("Context switches per notify burst:\r\n");
+	BenchPrintRatio("Notify burst", burstSwitches, 10000);
+	#if (configPSI_USE_PREEMPTION_THRESHOLD == 1)
+		BenchPrintRatio("Notify burst (threshold)", thresholdSwitches, 10000);
+	#endif
+	PsiFreeRTOS_BenchDelayedSweep(configPSI_BENCH_DELAYED_TASKS, 10000);
+}
+
+void PsiFreeRTOS_BenchIrqLatencyRun(uint32_t samples) {
+	//Large histograms, hence not on the stack
+	static PsiFreeRTOS_BenchHist hists[10];
+	static const char* entryNames[5] = {"Trigger->IRQ (resume)", "Trigger->IRQ (queue)", "Trigger->IRQ (semaphore)",
+										"Trigger->IRQ (notification)", "Trigger->IRQ (event group)"};
+	static const char* taskNames[5] = {"IRQ->task (resume)", "IRQ->task (queue)", "IRQ->task (semaphore)",
+									   "IRQ->task (notification)", "IRQ->task (event group)"};
+	PsiFreeRTOS_PmuInit();
+	for (uint32_t i = 0; i < 5; i++) {
+		PsiFreeRTOS_BenchHistReset(&hists[2*i], entryNames[i], 4);
+		PsiFreeRTOS_BenchHistReset(&hists[2*i+1], taskNames[i], 32);
+		PsiFreeRTOS_BenchIrqLatency((PsiFreeRTOS_BenchWake)i, samples, &hists[2*i], &hists[2*i+1]);
+	}
+	PsiFreeRTOS_BenchHistPrint(hists, 10);
+}
+
+#endif
@@ -0,0 +1,269 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if (configPSI_USE_BENCHMARK == 1)
+
+/*******************************************************************************************
+ * Types
+ *******************************************************************************************/
+/**
+ * @brief	Statistics of one benchmark in CPU cycles
+ */
+typedef struct {
+	const char* name;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t count;
+} PsiFreeRTOS_BenchStat;
+
+/**
+ * @brief	Statistics with histogram (for percentiles). The last bin counts all samples above
+ * 			the histogram range.
+ */
+typedef struct {
+	PsiFreeRTOS_BenchStat stat;
+	uint32_t binCycles;
+	uint32_t bins[configPSI_BENCH_HIST_BINS];
+} PsiFreeRTOS_BenchHist;
+
+/**
+ * @brief	Kernel object used to wake the task in the interrupt latency benchmark
+ */
+typedef enum {
+	PsiFreeRTOS_BenchWake_Resume = 0,
+	PsiFreeRTOS_BenchWake_Queue = 1,
+	PsiFreeRTOS_BenchWake_Semaphore = 2,
+	PsiFreeRTOS_BenchWake_Notification = 3,
+	PsiFreeRTOS_BenchWake_EventGroup = 4
+} PsiFreeRTOS_BenchWake;
+
+/*******************************************************************************************
+ * Inline Functions
+ *******************************************************************************************/
+/**
+ * @brief	Enable the PMU cycle counter (it is not enabled by the Xilinx BSP)
+ */
+static inline void PsiFreeRTOS_PmuInit(void) {
+	uint32_t pmcr;
+	__asm volatile ("MRC p15, 0, %0, c9, c12, 0" : "=r" (pmcr));
+	pmcr |= 0x5;	//Enable all counters, reset cycle counter
+	__asm volatile ("MCR p15, 0, %0, c9, c12, 0" :: "r" (pmcr));
+	__asm volatile ("MCR p15, 0, %0, c9, c12, 1" :: "r" (0x80000000UL));	//Enable cycle counter
+}
+
+/**
+ * @brief	Read the PMU cycle counter
+ *
+ * @return	CPU cycles (wraps around after 2^32 cycles)
+ */
+static inline uint32_t PsiFreeRTOS_PmuCycles(void) {
+	uint32_t cycles;
+	__asm volatile ("MRC p15, 0, %0, c9, c13, 0" : "=r" (cycles) :: "memory");
+	return cycles;
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Reset a benchmark statistics entry
+ *
+ * @param	stat_p	Statistics to reset
+ * @param	name	Name printed for the statistics
+ */
+void PsiFreeRTOS_BenchStatReset(PsiFreeRTOS_BenchStat* stat_p, const char* name);
+
+/**
+ * @brief	Add one sample to a benchmark statistics entry
+ *
+ * @param	stat_p	Statistics to update
+ * @param	cycles	Sample in CPU cycles
+ */
+void PsiFreeRTOS_BenchStatAdd(PsiFreeRTOS_BenchStat* stat_p, uint32_t cycles);
+
+/**
+ * @brief	Measure the cost of a yield round trip between two tasks (two context switches).
+ * 			Must be called from a task, the priority of the calling task is raised temporarily.
+ *
+ * @param	iterations	Number of round trips to measure
+ * @param	stat_p		Statistics to write the result to
+ */
+void PsiFreeRTOS_BenchYield(uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p);
+
+/**
+ * @brief	Measure the cost of a round trip between two tasks of the same priority signaling
+ * 			each other through the selected kernel object (two context switches and two
+ * 			send/receive pairs). Must be called from a task, the priority of the calling task
+ * 			is raised temporarily.
+ *
+ * @param	wake		Kernel object (PsiFreeRTOS_BenchWake_Queue, _Semaphore or _Notification)
+ * @param	iterations	Number of round trips to measure
+ * @param	stat_p		Statistics to write the result to
+ */
+void PsiFreeRTOS_BenchPingPong(PsiFreeRTOS_BenchWake wake, uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p);
+
+/**
+ * @brief	Measure a contended mutex: the calling task takes a mutex, wakes a higher priority
+ * 			task that takes the same mutex and gives the mutex back. With priority inheritance
+ * 			the woken task preempts, blocks and preempts again (four context switches), with a
+ * 			priority ceiling it only runs after the mutex is given back (two context switches).
+ * 			Must be called from a task, the priority of the calling task is raised temporarily.
+ *
+ * @param	ceiling		True = mutex with priority ceiling (requires configPSI_USE_CEILING_MUTEX),
+ * 						false = mutex with priority inheritance
+ * @param	iterations	Number of contentions to measure
+ * @param	stat_p		Statistics to write the result to
+ * @param	switches_p	Number of context switches during the measurement (output)
+ */
+void PsiFreeRTOS_BenchMutex(bool ceiling, uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p, uint32_t* switches_p);
+
+/**
+ * @brief	Measure the cost of the tick interrupt (entry, handler and exit). The calling task
+ * 			spins at the highest priority and records the gaps in the cycle counter, so all
+ * 			other interrupts must be quiet during the measurement. The task blocks for one
+ * 			tick after every configPSI_MAX_TICKS_WITHOUT_IDLE/2 ticks measured, so the
+ * 			infinite loop detection does not trigger.
+ *
+ * @param	ticks		Number of ticks to measure
+ * @param	stat_p		Statistics to write the result to
+ */
+void PsiFreeRTOS_BenchTick(uint32_t ticks, PsiFreeRTOS_BenchStat* stat_p);
+
+/**
+ * @brief	Measure a burst of notifications to a higher priority task that acknowledges each
+ * 			burst. Without threshold, the woken task preempts on every notification (two context
+ * 			switches each), with the preemption threshold of the calling task raised to the
+ * 			priority of the woken task, it only runs once the calling task blocks for the
+ * 			acknowledge (two context switches per burst).
+ * 			Must be called from a task, the priority of the calling task is raised temporarily.
+ *
+ * @param	threshold	True = raise the preemption threshold (requires configPSI_USE_PREEMPTION_THRESHOLD)
+ * @param	iterations	Number of bursts to measure
+ * @param	stat_p		Statistics to write the result to
+ * @param	switches_p	Number of context switches during the measurement (output)
+ */
+void PsiFreeRTOS_BenchThreshold(bool threshold, uint32_t iterations, PsiFreeRTOS_BenchStat* stat_p, uint32_t* switches_p);
+
+/**
+ * @brief	Measure the cost of the delayed task management versus the number of delayed tasks.
+ * 			The given number of low priority tasks is created, they sleep with spread wake
+ * 			times. Then a round trip between two tasks blocking with a timeout (insertion and
+ * 			removal from the delayed tasks) and the tick interrupt are measured.
+ * 			Must be called from a task, the priority of the calling task is raised temporarily.
+ *
+ * @param	tasks		Number of sleeping tasks (configPSI_MAX_TASKS must allow them)
+ * @param	iterations	Number of round trips to measure
+ * @param	block_p		Statistics to write the round trip result to
+ * @param	tick_p		Statistics to write the tick interrupt result to
+ * @return				False if a task could not be created (a message is printed and the
+ * 						tasks created are deleted again)
+ */
+bool PsiFreeRTOS_BenchDelayed(uint32_t tasks, uint32_t iterations, PsiFreeRTOS_BenchStat* block_p, PsiFreeRTOS_BenchStat* tick_p);
+
+/**
+ * @brief	Run PsiFreeRTOS_BenchDelayed() for 0, 1, 2, 4, ... sleeping tasks up to maxTasks
+ * 			and print the average and maximum of both measurements for each point. The sweep
+ * 			is aborted if the tasks cannot be created. Must be called from a task.
+ *
+ * @param	maxTasks	Number of sleeping tasks of the last point
+ * @param	iterations	Number of round trips to measure per point
+ */
+void PsiFreeRTOS_BenchDelayedSweep(uint32_t maxTasks, uint32_t iterations);
+
+/**
+ * @brief	Reset a histogram
+ *
+ * @param	hist_p		Histogram to reset
+ * @param	name		Name printed for the histogram
+ * @param	binCycles	Width of one bin in CPU cycles
+ */
+void PsiFreeRTOS_BenchHistReset(PsiFreeRTOS_BenchHist* hist_p, const char* name, uint32_t binCycles);
+
+/**
+ * @brief	Add one sample to a histogram
+ *
+ * @param	hist_p	Histogram to update
+ * @param	cycles	Sample in CPU cycles
+ */
+void PsiFreeRTOS_BenchHistAdd(PsiFreeRTOS_BenchHist* hist_p, uint32_t cycles);
+
+/**
+ * @brief	Get a percentile from a histogram (resolution is one bin)
+ *
+ * @param	hist_p		Histogram
+ * @param	permille	Percentile in 1/1000 (e.g. 990 for P99)
+ * @return				Upper bound of the bin containing the percentile in CPU cycles (the
+ * 						maximum if the percentile is above the histogram range)
+ */
+uint32_t PsiFreeRTOS_BenchHistPercentile(const PsiFreeRTOS_BenchHist* hist_p, uint16_t permille);
+
+/**
+ * @brief	Measure the interrupt latency. A software generated interrupt (configPSI_BENCH_SGI_ID)
+ * 			is triggered from a task and the handler wakes a task waiting on the selected
+ * 			kernel object. Must be called from a task, the priority of the calling task is
+ * 			raised temporarily. The calling task blocks for the rest of the tick
+ * 			after every 10 samples, so lower priority tasks run between the samples.
+ *
+ * @param	wake		Kernel object used to wake the task
+ * @param	samples		Number of interrupts to measure
+ * @param	entry_p		Histogram for trigger to handler entry (may be NULL)
+ * @param	task_p		Histogram for handler entry to woken task running
+ */
+void PsiFreeRTOS_BenchIrqLatency(PsiFreeRTOS_BenchWake wake, uint32_t samples,
+								 PsiFreeRTOS_BenchHist* entry_p, PsiFreeRTOS_BenchHist* task_p);
+
+/**
+ * @brief	Print benchmark statistics as table
+ *
+ * @param	stats_p		Array of statistics
+ * @param	count		Number of entries in the array
+ */
+void PsiFreeRTOS_BenchPrint(const PsiFreeRTOS_BenchStat* stats_p, uint16_t count);
+
+/**
+ * @brief	Print histograms as table (including P99)
+ *
+ * @param	hists_p		Array of histograms
+ * @param	count		Number of entries in the array
+ */
+void PsiFreeRTOS_BenchHistPrint(const PsiFreeRTOS_BenchHist* hists_p, uint16_t count);
+
+/**
+ * @brief	Print the configuration settings affecting the benchmark results
+ */
+void PsiFreeRTOS_BenchPrintConfig();
+
+/**
+ * @brief	Run all benchmarks and print the results. Must be called from a task.
+ */
+void PsiFreeRTOS_BenchRun();
+
+/**
+ * @brief	Run the interrupt latency benchmark for all wake-up methods and print the
+ * 			results. Must be called from a task.
+ *
+ * @param	samples		Number of interrupts to measure per wake-up method
+ */
+void PsiFreeRTOS_BenchIrqLatencyRun(uint32_t samples);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,357 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Default values for optional PSI specific configuration settings. Every setting can be
+ * overwritten in FreeRTOSConfig.h. This file is included by FreeRTOS.h right after
+ * FreeRTOSConfig.h, so the settings are also visible to the kernel sources.
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * High Resolution Timer
+ *******************************************************************************************/
+//Enable microsecond resolution delays and timeouts (requires a free TTC channel)
+#ifndef configPSI_USE_HRTIMER
+	#define configPSI_USE_HRTIMER 0
+#endif
+
+//Number of high resolution timeouts that can be active at the same time
+#ifndef configPSI_HRTIMER_MAX_WAITERS
+	#define configPSI_HRTIMER_MAX_WAITERS 8
+#endif
+
+//Remaining times below this value are busy-waited instead of blocking
+#ifndef configPSI_HRTIMER_MIN_BLOCK_US
+	#define configPSI_HRTIMER_MIN_BLOCK_US 20
+#endif
+
+//Retry interval if a task was not yet blocked when its timeout expired
+#ifndef configPSI_HRTIMER_RETRY_US
+	#define configPSI_HRTIMER_RETRY_US 5
+#endif
+
+//GIC priority of the high resolution timer interrupt (must allow FreeRTOS API calls)
+#ifndef configPSI_HRTIMER_IRQ_PRIORITY
+	#define configPSI_HRTIMER_IRQ_PRIORITY configMAX_API_CALL_INTERRUPT_PRIORITY
+#endif
+
+/*******************************************************************************************
+ * Benchmark
+ *******************************************************************************************/
+//Include the kernel benchmarks (PsiFreeRTOS_Bench.h)
+#ifndef configPSI_USE_BENCHMARK
+	#define configPSI_USE_BENCHMARK 0
+#endif
+
+//Software generated interrupt used by the interrupt latency benchmark
+#ifndef configPSI_BENCH_SGI_ID
+	#define configPSI_BENCH_SGI_ID 14
+#endif
+
+//Number of bins of the benchmark histograms
+#ifndef configPSI_BENCH_HIST_BINS
+	#define configPSI_BENCH_HIST_BINS 256
+#endif
+
+//Number of sleeping tasks in the delayed task benchmark
+#ifndef configPSI_BENCH_DELAYED_TASKS
+	#define configPSI_BENCH_DELAYED_TASKS 16
+#endif
+
+/*******************************************************************************************
+ * MPU Stack Guard
+ *******************************************************************************************/
+//Protect the lowest bytes of the running task's stack with an MPU no-access region
+//... (replaces the software checks selected by configCHECK_FOR_STACK_OVERFLOW)
+#ifndef configPSI_USE_MPU_STACK_GUARD
+	#define configPSI_USE_MPU_STACK_GUARD 0
+#endif
+
+//MPU region used for the guard (highest region number has the highest priority)
+#ifndef configPSI_MPU_STACK_GUARD_REGION
+	#define configPSI_MPU_STACK_GUARD_REGION 15
+#endif
+
+//Size of the guard in bytes (power of two, at least 32). Large on-stack arrays can only jump
+//... over the guard if they are larger than this value.
+#ifndef configPSI_MPU_STACK_GUARD_SIZE
+	#define configPSI_MPU_STACK_GUARD_SIZE 256
+#endif
+
+/*******************************************************************************************
+ * Inter-Core Communication (RPU split mode)
+ *******************************************************************************************/
+//Enable the inter-core message queue between R5_0 and R5_1 (requires
+//..configPSI_IPC_IPI_ID, configPSI_IPC_IPI_INTR and configPSI_IPC_PEER_IPI_MASK)
+#ifndef configPSI_USE_IPC
+	#define configPSI_USE_IPC 0
+#endif
+
+//Shared memory for the message rings (same on both cores, power of two, aligned to its size)
+#ifndef configPSI_IPC_SHMEM_BASE
+	#define configPSI_IPC_SHMEM_BASE 0xFFFC0000
+#endif
+
+#ifndef configPSI_IPC_SHMEM_SIZE
+	#define configPSI_IPC_SHMEM_SIZE 0x10000
+#endif
+
+//MPU region used to map the shared memory non-cacheable
+#ifndef configPSI_IPC_MPU_REGION
+	#define configPSI_IPC_MPU_REGION 14
+#endif
+
+//Size of one message in bytes and number of messages per direction (same on both cores)
+#ifndef configPSI_IPC_ITEM_SIZE
+	#define configPSI_IPC_ITEM_SIZE 16
+#endif
+
+#ifndef configPSI_IPC_QUEUE_LENGTH
+	#define configPSI_IPC_QUEUE_LENGTH 64
+#endif
+
+//GIC priority of the IPI interrupt (must allow FreeRTOS API calls)
+#ifndef configPSI_IPC_IRQ_PRIORITY
+	#define configPSI_IPC_IRQ_PRIORITY configMAX_API_CALL_INTERRUPT_PRIORITY
+#endif
+
+/*******************************************************************************************
+ * Time Synchronization with the System Counter
+ *******************************************************************************************/
+//Periodically correlate the PsiFreeRTOS time base with the system timestamp generator
+//..(the counter used by the APU). Requires configGENERATE_RUN_TIME_STATS and configUSE_TIMERS.
+#ifndef configPSI_USE_TIMESYNC
+	#define configPSI_USE_TIMESYNC 0
+#endif
+
+//Synchronization period in ticks
+#ifndef configPSI_TIMESYNC_PERIOD_TICKS
+	#define configPSI_TIMESYNC_PERIOD_TICKS configTICK_RATE_HZ
+#endif
+
+//Base address of the system timestamp generator (IOU_SCNTRS)
+#ifndef configPSI_TIMESYNC_SYSCNT_BASEADDR
+	#define configPSI_TIMESYNC_SYSCNT_BASEADDR 0xFF260000
+#endif
+
+//Weight of a new drift measurement as power of two (the drift is averaged over 2^N periods)
+#ifndef configPSI_TIMESYNC_DRIFT_FILTER_SHIFT
+	#define configPSI_TIMESYNC_DRIFT_FILTER_SHIFT 3
+#endif
+
+/*******************************************************************************************
+ * Fast Tick
+ *******************************************************************************************/
+//Handle the tick interrupt without the interrupt table dispatch and acknowledge the timer
+//..with direct register accesses (for high tick rates)
+#ifndef configPSI_USE_FAST_TICK
+	#define configPSI_USE_FAST_TICK 0
+#endif
+
+//With the fast tick, the time base is read in the tick hook only every N ticks. The 32-bit
+//..runtime statistics timer must not wrap within this time.
+#ifndef configPSI_FAST_TICK_TIMEBASE_TICKS
+	#define configPSI_FAST_TICK_TIMEBASE_TICKS 256
+#endif
+
+/*******************************************************************************************
+ * Exception Stack Statistics
+ *******************************************************************************************/
+//Report the high water marks of the stacks defined in the linker script and the maximum
+//..interrupt nesting depth in PsiFreeRTOS_PrintStackWatermark()
+#ifndef configPSI_USE_EXCEPTION_STACK_STATS
+	#define configPSI_USE_EXCEPTION_STACK_STATS 0
+#endif
+
+/*******************************************************************************************
+ * Tick Statistics
+ *******************************************************************************************/
+//Measure the lateness of the tick interrupt and count lost and pended ticks
+#ifndef configPSI_USE_TICK_STATS
+	#define configPSI_USE_TICK_STATS 0
+#endif
+
+//Number of bins of the lateness histogram and width of one bin in nanoseconds
+#ifndef configPSI_TICK_STATS_BINS
+	#define configPSI_TICK_STATS_BINS 16
+#endif
+
+#ifndef configPSI_TICK_STATS_BIN_NS
+	#define configPSI_TICK_STATS_BIN_NS 1000
+#endif
+
+/*******************************************************************************************
+ * Interrupt Storm Guard
+ *******************************************************************************************/
+//Count the interrupts per period and disable interrupts exceeding their rate limit
+#ifndef configPSI_USE_IRQ_GUARD
+	#define configPSI_USE_IRQ_GUARD 0
+#endif
+
+//Period the interrupts are counted over in ticks
+#ifndef configPSI_IRQ_GUARD_PERIOD_TICKS
+	#define configPSI_IRQ_GUARD_PERIOD_TICKS configTICK_RATE_HZ
+#endif
+
+//Rate limit of all interrupts after initialization (interrupts per period, 0 = no limit)
+#ifndef configPSI_IRQ_GUARD_DEFAULT_LIMIT
+	#define configPSI_IRQ_GUARD_DEFAULT_LIMIT 0
+#endif
+
+/*******************************************************************************************
+ * Work Queues
+ *******************************************************************************************/
+//Enable work queues for deferred interrupt processing (PsiFreeRTOS_WorkQueue.h). Requires
+//..configGENERATE_RUN_TIME_STATS.
+#ifndef configPSI_USE_WORKQUEUE
+	#define configPSI_USE_WORKQUEUE 0
+#endif
+
+//Maximum number of work queues
+#ifndef configPSI_WORKQUEUE_MAX_QUEUES
+	#define configPSI_WORKQUEUE_MAX_QUEUES 4
+#endif
+
+/*******************************************************************************************
+ * DMA Memory Copy
+ *******************************************************************************************/
+//Enable memory copies with the ZDMA (PsiFreeRTOS_Dma.h). Requires configPSI_DMA_DEVICE_ID_FIRST
+//..and configPSI_DMA_INTR_FIRST.
+#ifndef configPSI_USE_DMA
+	#define configPSI_USE_DMA 0
+#endif
+
+//Copy with the CPU instead of the DMA (for testing without the ZDMA)
+#ifndef configPSI_DMA_USE_CPU
+	#define configPSI_DMA_USE_CPU 0
+#endif
+
+//Number of DMA channels used, starting at configPSI_DMA_DEVICE_ID_FIRST (device IDs and
+//..interrupts of the channels must be consecutive)
+#ifndef configPSI_DMA_CHANNELS
+	#define configPSI_DMA_CHANNELS 2
+#endif
+
+//GIC priority of the DMA interrupts (must allow FreeRTOS API calls)
+#ifndef configPSI_DMA_IRQ_PRIORITY
+	#define configPSI_DMA_IRQ_PRIORITY configMAX_API_CALL_INTERRUPT_PRIORITY
+#endif
+
+/*******************************************************************************************
+ * Earliest Deadline First Scheduling
+ *******************************************************************************************/
+//Schedule the tasks of one priority level by their deadline instead of round robin
+#ifndef configPSI_USE_EDF
+	#define configPSI_USE_EDF 0
+#endif
+
+//Priority level scheduled by deadline (higher priorities preempt EDF tasks as usual)
+#ifndef configPSI_EDF_PRIORITY
+	#define configPSI_EDF_PRIORITY 1
+#endif
+
+/*******************************************************************************************
+ * Priority Ceiling Mutexes
+ *******************************************************************************************/
+//Enable mutexes with immediate priority ceiling (xSemaphoreCreateMutexWithCeiling()). Requires
+//..configUSE_MUTEXES.
+#ifndef configPSI_USE_CEILING_MUTEX
+	#define configPSI_USE_CEILING_MUTEX 0
+#endif
+
+/*******************************************************************************************
+ * Delayed Task Wheel
+ *******************************************************************************************/
+//Store blocked tasks with timeout in a timing wheel instead of the sorted delayed lists
+#ifndef configPSI_USE_DELAY_WHEEL
+	#define configPSI_USE_DELAY_WHEEL 0
+#endif
+
+//Number of wheel slots (power of two)
+#ifndef configPSI_DELAY_WHEEL_SLOTS
+	#define configPSI_DELAY_WHEEL_SLOTS 64
+#endif
+
+/*******************************************************************************************
+ * Tick Catch-Up
+ *******************************************************************************************/
+//Process the ticks pended while the scheduler was suspended in one pass when it is resumed
+#ifndef configPSI_USE_TICK_CATCH_UP
+	#define configPSI_USE_TICK_CATCH_UP 0
+#endif
+
+//Tick hook: 0 = called from the tick interrupt also while the scheduler is suspended (FreeRTOS
+//..behavior), 1 = not called while the scheduler is suspended but once after the catch-up
+#ifndef configPSI_TICK_CATCH_UP_HOOK
+	#define configPSI_TICK_CATCH_UP_HOOK 0
+#endif
+
+/*******************************************************************************************
+ * CPU Reservations
+ *******************************************************************************************/
+//Limit the execution time of tasks to a budget per period (requires configGENERATE_RUN_TIME_STATS)
+#ifndef configPSI_USE_RESERVATION
+	#define configPSI_USE_RESERVATION 0
+#endif
+
+//Maximum number of tasks with a reservation (all are checked in the tick)
+#ifndef configPSI_RESERVATION_MAX_TASKS
+	#define configPSI_RESERVATION_MAX_TASKS 8
+#endif
+
+//Priority of demoted tasks while their budget is exhausted
+#ifndef configPSI_RESERVATION_DEMOTE_PRIORITY
+	#define configPSI_RESERVATION_DEMOTE_PRIORITY 0
+#endif
+
+/*******************************************************************************************
+ * Task Pool
+ *******************************************************************************************/
+//Pre-allocated TCB and stack slots for xTaskCreateFromPool()
+#ifndef configPSI_USE_TASK_POOL
+	#define configPSI_USE_TASK_POOL 0
+#endif
+
+//Number of slots
+#ifndef configPSI_TASK_POOL_SIZE
+	#define configPSI_TASK_POOL_SIZE 4
+#endif
+
+//Stack depth of each slot in words
+#ifndef configPSI_TASK_POOL_STACK_DEPTH
+	#define configPSI_TASK_POOL_STACK_DEPTH (configMINIMAL_STACK_SIZE * 2)
+#endif
+
+/*******************************************************************************************
+ * Time Slice Quantum
+ *******************************************************************************************/
+//Per task number of ticks before equal priority tasks are rotated (configUSE_TIME_SLICING)
+#ifndef configPSI_USE_TIME_SLICE_QUANTUM
+	#define configPSI_USE_TIME_SLICE_QUANTUM 0
+#endif
+
+//Quantum of new tasks in ticks (1 = FreeRTOS behavior)
+#ifndef configPSI_TIME_SLICE_DEFAULT_QUANTUM
+	#define configPSI_TIME_SLICE_DEFAULT_QUANTUM 1
+#endif
+
+/*******************************************************************************************
+ * Preemption Threshold
+ *******************************************************************************************/
+//Per task preemption threshold, the running task is only preempted by tasks of higher priority
+//..than its threshold
+#ifndef configPSI_USE_PREEMPTION_THRESHOLD
+	#define configPSI_USE_PREEMPTION_THRESHOLD 0
+#endif
+
+/*******************************************************************************************
+ * Task Notification Arrays
+ *******************************************************************************************/
+//Number of notification values per task, accessed by the "Indexed" notification functions
+//..(1 = FreeRTOS behavior)
+#ifndef configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
@@ -0,0 +1,253 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_Dma.h"
+#include "PsiFreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include <string.h>
+#if (configPSI_DMA_USE_CPU == 0)
+	#include "semphr.h"
+	#include "xzdma.h"
+	#include "xscugic.h"
+	#include "xil_cache.h"
+	#include <xparameters.h>
+#endif
+
+#if (configPSI_USE_DMA == 1) && (configPSI_DMA_USE_CPU == 1)
+
+/*******************************************************************************************
+ * Public Functions (CPU fallback)
+ *******************************************************************************************/
+void PsiFreeRTOS_DmaInit() {
+}
+
+BaseType_t PsiFreeRTOS_DmaCopy(void* dst_p, const void* src_p, uint32_t len, TickType_t timeout) {
+	memcpy(dst_p, src_p, len);
+	return pdTRUE;
+}
+
+BaseType_t PsiFreeRTOS_DmaCopyAsync(void* dst_p, const void* src_p, uint32_t len,
+									PsiFreeRTOS_DmaCallback callback_p, void* arg_p, TickType_t timeout) {
+	memcpy(dst_p, src_p, len);
+	if (NULL != callback_p) {
+		callback_p(arg_p, true);
+	}
+	return pdTRUE;
+}
+
+#elif (configPSI_USE_DMA == 1)
+
+#ifndef configPSI_DMA_DEVICE_ID_FIRST
+	#error configPSI_DMA_DEVICE_ID_FIRST must be defined when configPSI_USE_DMA is 1
+#endif
+
+#ifndef configPSI_DMA_INTR_FIRST
+	#error configPSI_DMA_INTR_FIRST must be defined when configPSI_USE_DMA is 1
+#endif
+
+#if (configPSI_DMA_CHANNELS < 1) || (configPSI_DMA_CHANNELS > 8)
+	#error configPSI_DMA_CHANNELS must be in the range 1 ... 8
+#endif
+
+/*******************************************************************************************
+ * Private Types and Constants
+ *******************************************************************************************/
+typedef struct {
+	XZDma zdma;
+	volatile bool done;
+	volatile bool success;
+	//Either a blocked task or a callback is notified on completion
+	TaskHandle_t waiter;
+	#if (configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES == 1)
+		SemaphoreHandle_t doneSem;
+	#endif
+	PsiFreeRTOS_DmaCallback callback_p;
+	void* arg_p;
+} DmaChannel;
+
+//Maximum size of one transfer in simple mode
+#define DMA_MAX_LEN		(1UL << 30)
+
+//With notification arrays, blocking copies wait on the last notification value of the task.
+//..Without, they wait on a binary semaphore of the channel, the only notification value is
+//..left to the application.
+#define DMA_NOTIFY_INDEX	(configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+
+/*******************************************************************************************
+ * Private Variables
+ *******************************************************************************************/
+static DmaChannel dmaChannels[configPSI_DMA_CHANNELS];
+static SemaphoreHandle_t dmaFree;
+static uint32_t dmaFreeMask;
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+static void DmaDoneHandler(void* arg_p) {
+	DmaChannel* ch_p = (DmaChannel*)arg_p;
+	ch_p->success = true;
+	ch_p->done = true;
+}
+
+static void DmaErrorHandler(void* arg_p, u32 mask) {
+	DmaChannel* ch_p = (DmaChannel*)arg_p;
+	ch_p->success = false;
+	ch_p->done = true;
+}
+
+static DmaChannel* DmaAcquire(TickType_t timeout) {
+	if (pdTRUE != xSemaphoreTake(dmaFree, timeout)) {
+		return NULL;
+	}
+	taskENTER_CRITICAL();
+	const uint32_t idx = __builtin_ctz(dmaFreeMask);
+	dmaFreeMask &= ~(1UL << idx);
+	taskEXIT_CRITICAL();
+	return &dmaChannels[idx];
+}
+
+static void DmaRelease(DmaChannel* ch_p) {
+	taskENTER_CRITICAL();
+	dmaFreeMask |= (1UL << (ch_p - dmaChannels));
+	taskEXIT_CRITICAL();
+	xSemaphoreGive(dmaFree);
+}
+
+static void DmaReleaseFromISR(DmaChannel* ch_p, BaseType_t* higherPrioWoken_p) {
+	const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+	dmaFreeMask |= (1UL << (ch_p - dmaChannels));
+	taskEXIT_CRITICAL_FROM_ISR(mask);
+	xSemaphoreGiveFromISR(dmaFree, higherPrioWoken_p);
+}
+
+//The destination is cleaned and invalidated too, so no dirty line can be evicted over the
+//..DMA data and no stale line is hit after the transfer (as long as the destination is not
+//..accessed during the transfer).
+static bool DmaStart(DmaChannel* ch_p, void* dst_p, const void* src_p, uint32_t len) {
+	Xil_DCacheFlushRange((INTPTR)src_p, len);
+	Xil_DCacheFlushRange((INTPTR)dst_p, len);
+	XZDma_Transfer transfer;
+	transfer.SrcAddr = (UINTPTR)src_p;
+	transfer.DstAddr = (UINTPTR)dst_p;
+	transfer.Size = len;
+	transfer.SrcCoherent = 0;
+	transfer.DstCoherent = 0;
+	transfer.Pause = 0;
+	ch_p->done = false;
+	return XST_SUCCESS == XZDma_Start(&ch_p->zdma, &transfer, 1);
+}
+
+static void DmaIsr(void* arg_p) {
+	BaseType_t higherPrioWoken = pdFALSE;
+	DmaChannel* ch_p = (DmaChannel*)arg_p;
+	XZDma_IntrHandler(&ch_p->zdma);
+	if (!ch_p->done) {
+		return;
+	}
+
+	//A blocked task releases the channel itself after reading the result
+	if (NULL != ch_p->waiter) {
+		#if (configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES == 1)
+			xSemaphoreGiveFromISR(ch_p->doneSem, &higherPrioWoken);
+		#else
+			vTaskNotifyGiveIndexedFromISR(ch_p->waiter, DMA_NOTIFY_INDEX, &higherPrioWoken);
+		#endif
+	}
+	else {
+		//Release the channel before the callback (it may start the next copy)
+		const PsiFreeRTOS_DmaCallback callback_p = ch_p->callback_p;
+		void* const cbArg_p = ch_p->arg_p;
+		const bool success = ch_p->success;
+		DmaReleaseFromISR(ch_p, &higherPrioWoken);
+		if (NULL != callback_p) {
+			callback_p(cbArg_p, success);
+		}
+	}
+	portYIELD_FROM_ISR(higherPrioWoken);
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+void PsiFreeRTOS_DmaInit() {
+	dmaFree = xSemaphoreCreateCounting(configPSI_DMA_CHANNELS, 0);
+	dmaFreeMask = 0;
+	for (uint32_t i = 0; i < configPSI_DMA_CHANNELS; i++) {
+		DmaChannel* ch_p = &dmaChannels[i];
+		#if (configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES == 1)
+			ch_p->doneSem = xSemaphoreCreateBinary();
+			if (NULL == ch_p->doneSem) {
+				printfInt("In %s: DMA channel %d semaphore creation failed...\r\n", __func__, i);
+				continue;
+			}
+		#endif
+		XZDma_Config* config_p = XZDma_LookupConfig(configPSI_DMA_DEVICE_ID_FIRST + i);
+		if ((NULL == config_p) || (XST_SUCCESS != XZDma_CfgInitialize(&ch_p->zdma, config_p, config_p->BaseAddress))) {
+			printfInt("In %s: DMA channel %d initialization failed...\r\n", __func__, i);
+			continue;
+		}
+		XZDma_SetMode(&ch_p->zdma, FALSE, XZDMA_NORMAL_MODE);
+		XZDma_SetCallBack(&ch_p->zdma, XZDMA_HANDLER_DONE, (void*)DmaDoneHandler, ch_p);
+		XZDma_SetCallBack(&ch_p->zdma, XZDMA_HANDLER_ERROR, (void*)DmaErrorHandler, ch_p);
+
+		//Install interrupt with the configured priority (keep trigger type)
+		uint8_t prio, trigger;
+		xPortInstallInterruptHandler(configPSI_DMA_INTR_FIRST + i, DmaIsr, ch_p);
+		XScuGic_GetPriorityTriggerType(PsiFreeRTOS_GetXScuGic(), configPSI_DMA_INTR_FIRST + i, &prio, &trigger);
+		XScuGic_SetPriorityTriggerType(PsiFreeRTOS_GetXScuGic(), configPSI_DMA_INTR_FIRST + i,
+									   configPSI_DMA_IRQ_PRIORITY << portPRIORITY_SHIFT, trigger);
+		vPortEnableInterrupt(configPSI_DMA_INTR_FIRST + i);
+		XZDma_EnableIntr(&ch_p->zdma, XZDMA_IXR_ALL_INTR_MASK);
+
+		dmaFreeMask |= (1UL << i);
+		xSemaphoreGive(dmaFree);
+	}
+}
+
+BaseType_t PsiFreeRTOS_DmaCopy(void* dst_p, const void* src_p, uint32_t len, TickType_t timeout) {
+	configASSERT(len < DMA_MAX_LEN);
+	DmaChannel* ch_p = DmaAcquire(timeout);
+	if (NULL == ch_p) {
+		return pdFALSE;
+	}
+	ch_p->waiter = xGetCurrentTaskHandle();
+	ch_p->callback_p = NULL;
+	if (!DmaStart(ch_p, dst_p, src_p, len)) {
+		DmaRelease(ch_p);
+		return pdFALSE;
+	}
+
+	//Exactly the one completion given by the interrupt is consumed. The channel is still
+	//..owned by this task, so no other copy can give it in between.
+	#if (configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES == 1)
+		xSemaphoreTake(ch_p->doneSem, portMAX_DELAY);
+	#else
+		ulTaskNotifyTakeIndexed(DMA_NOTIFY_INDEX, pdFALSE, portMAX_DELAY);
+	#endif
+	const bool success = ch_p->success;
+	DmaRelease(ch_p);
+	return success ? pdTRUE : pdFALSE;
+}
+
+BaseType_t PsiFreeRTOS_DmaCopyAsync(void* dst_p, const void* src_p, uint32_t len,
+									PsiFreeRTOS_DmaCallback callback_p, void* arg_p, TickType_t timeout) {
+	configASSERT(len < DMA_MAX_LEN);
+	DmaChannel* ch_p = DmaAcquire(timeout);
+	if (NULL == ch_p) {
+		return pdFALSE;
+	}
+	ch_p->waiter = NULL;
+	ch_p->callback_p = callback_p;
+	ch_p->arg_p = arg_p;
+	if (!DmaStart(ch_p, dst_p, src_p, len)) {
+		DmaRelease(ch_p);
+		return pdFALSE;
+	}
+	return pdTRUE;
+}
+
+#endif
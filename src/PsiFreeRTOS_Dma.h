@@ -0,0 +1,76 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if (configPSI_USE_DMA == 1)
+
+/*******************************************************************************************
+ * Types
+ *******************************************************************************************/
+/**
+ * @brief	Function called when an asynchronous copy is completed. It is called from
+ * 			interrupt context (from the calling task if configPSI_DMA_USE_CPU is 1).
+ *
+ * @param	arg_p		Argument passed to PsiFreeRTOS_DmaCopyAsync()
+ * @param	success		False if the DMA reported an error
+ */
+typedef void (*PsiFreeRTOS_DmaCallback)(void* arg_p, bool success);
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Initialize the DMA channels. This function is called by PsiFreeRTOS_Init()
+ * 			and must not be called by the user.
+ */
+void PsiFreeRTOS_DmaInit();
+
+/**
+ * @brief	Copy memory with the DMA and block until the copy is completed. The calling
+ * 			task waits for a free channel and for the completion on a binary semaphore of the
+ * 			channel (on the last task notification of the array if
+ * 			configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES > 1).
+ * 			The caches are maintained by the function.
+ *
+ * @param	dst_p		Destination (should be aligned to the cache line size, see Functionality.md)
+ * @param	src_p		Source
+ * @param	len			Number of bytes to copy
+ * @param	timeout		Maximum time to wait for a free channel in ticks
+ * @return				pdTRUE on success, pdFALSE if no channel got free or the DMA reported an error
+ */
+BaseType_t PsiFreeRTOS_DmaCopy(void* dst_p, const void* src_p, uint32_t len, TickType_t timeout);
+
+/**
+ * @brief	Start a DMA copy and return immediately. The callback is called when the copy
+ * 			is completed, the destination must not be accessed before.
+ *
+ * @param	dst_p		Destination (should be aligned to the cache line size, see Functionality.md)
+ * @param	src_p		Source
+ * @param	len			Number of bytes to copy
+ * @param	callback_p	Function called on completion (may be NULL)
+ * @param	arg_p		Argument passed to the callback
+ * @param	timeout		Maximum time to wait for a free channel in ticks
+ * @return				pdTRUE if the copy was started, pdFALSE if no channel got free
+ */
+BaseType_t PsiFreeRTOS_DmaCopyAsync(void* dst_p, const void* src_p, uint32_t len,
+									PsiFreeRTOS_DmaCallback callback_p, void* arg_p, TickType_t timeout);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
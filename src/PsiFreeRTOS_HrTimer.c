@@ -0,0 +1,307 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_HrTimer.h"
+#include "PsiFreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "timers.h"
+#include "xttcps.h"
+#include "xscugic.h"
+#include <xparameters.h>
+
+#if (configPSI_USE_HRTIMER == 1)
+
+#ifndef configPSI_TIMER_HRTIMER_ID
+	#error configPSI_TIMER_HRTIMER_ID must be defined when configPSI_USE_HRTIMER is 1
+#endif
+
+#ifndef configPSI_TIMER_HRTIMER_INTR
+	#error configPSI_TIMER_HRTIMER_INTR must be defined when configPSI_USE_HRTIMER is 1
+#endif
+
+#if (INCLUDE_xTaskAbortDelay != 1)
+	#error INCLUDE_xTaskAbortDelay must be 1 when configPSI_USE_HRTIMER is 1
+#endif
+
+#if (configUSE_TIMERS != 1) || (INCLUDE_xTimerPendFunctionCall != 1)
+	#error configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall must be 1 when configPSI_USE_HRTIMER is 1
+#endif
+
+/*******************************************************************************************
+ * Private Types and Constants
+ *******************************************************************************************/
+typedef struct {
+	TaskHandle_t task;		//NULL = slot free
+	uint64_t deadline;		//HRTIMER_DEADLINE_DONE = task was woken already
+	bool deferred;			//Abort of an event wait handed to the timer daemon task
+} HrWaiter;
+
+#define HRTIMER_DEADLINE_DONE	UINT64_MAX
+#define HRTIMER_MAX_MATCH_DIST	0x80000000ULL
+
+/*******************************************************************************************
+ * Private Variables
+ *******************************************************************************************/
+static XTtcPs hrTimerInstance;
+static uint32_t countsPerUs;
+static uint64_t countsPerTick;
+static uint64_t retryCounts;
+static volatile uint32_t timeHigh;
+static volatile uint32_t timeLastLow;
+static HrWaiter hrWaiters[configPSI_HRTIMER_MAX_WAITERS];
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+//Must be called with interrupts masked. The overflow interrupt ensures the function is
+//..called at least once per counter wrap.
+static uint64_t HrGetTimeInternal() {
+	const uint32_t low = XTtcPs_GetCounterValue(&hrTimerInstance);
+	if (low < timeLastLow) {
+		timeHigh++;
+	}
+	timeLastLow = low;
+	return ((uint64_t)timeHigh << 32) | low;
+}
+
+//Program the match register for the earliest pending deadline. Must be called with interrupts masked.
+static void HrArm(const uint64_t now) {
+	uint64_t next = HRTIMER_DEADLINE_DONE;
+	for (int i = 0; i < configPSI_HRTIMER_MAX_WAITERS; i++) {
+		if ((NULL != hrWaiters[i].task) && !hrWaiters[i].deferred && (hrWaiters[i].deadline < next)) {
+			next = hrWaiters[i].deadline;
+		}
+	}
+
+	//Nothing to do
+	if (HRTIMER_DEADLINE_DONE == next) {
+		XTtcPs_DisableInterrupts(&hrTimerInstance, XTTCPS_IXR_MATCH_0_MASK);
+		return;
+	}
+
+	//Deadlines beyond the 32-bit match range are approached with intermediate matches (the ISR
+	//..re-evaluates the waiters and re-arms)
+	if (next > now + HRTIMER_MAX_MATCH_DIST) {
+		next = now + HRTIMER_MAX_MATCH_DIST;
+	}
+
+	//Expired deadlines of tasks that were not yet blocked are retried a bit later
+	if (next < now + retryCounts) {
+		next = now + retryCounts;
+	}
+	uint32_t match = (uint32_t)next;
+	XTtcPs_WriteReg(hrTimerInstance.Config.BaseAddress, XTTCPS_MATCH_0_OFFSET, match);
+	XTtcPs_EnableInterrupts(&hrTimerInstance, XTTCPS_IXR_MATCH_0_MASK);
+
+	//Ensure the counter did not pass the match value while it was written (e.g. due to non-maskable IRQs)
+	for (;;) {
+		const uint32_t counter = XTtcPs_GetCounterValue(&hrTimerInstance);
+		if ((int32_t)(match - counter) > 0) {
+			break;
+		}
+		match = counter + (uint32_t)retryCounts;
+		XTtcPs_WriteReg(hrTimerInstance.Config.BaseAddress, XTTCPS_MATCH_0_OFFSET, match);
+	}
+}
+
+//Abort an event wait from the timer daemon task (event lists must not be modified from interrupts)
+static void HrAbortDeferred(void* arg_p, uint32_t slot) {
+	//The waiting task cannot return and stop the timeout while the scheduler is suspended
+	vTaskSuspendAll();
+	taskENTER_CRITICAL();
+	const TaskHandle_t task = hrWaiters[slot].deferred ? hrWaiters[slot].task : NULL;
+	taskEXIT_CRITICAL();
+	if (NULL != task) {
+		const BaseType_t aborted = xTaskAbortDelay(task);
+		taskENTER_CRITICAL();
+		hrWaiters[slot].deferred = false;
+		//If the task is not yet blocked, the deadline stays pending and is retried
+		if (pdPASS == aborted) {
+			hrWaiters[slot].deadline = HRTIMER_DEADLINE_DONE;
+		}
+		HrArm(HrGetTimeInternal());
+		taskEXIT_CRITICAL();
+	}
+	xTaskResumeAll();
+}
+
+static void HrTimerIsr(void* arg_p) {
+	BaseType_t higherPrioWoken = pdFALSE;
+	const uint32_t status = XTtcPs_GetInterruptStatus(&hrTimerInstance);
+	XTtcPs_ClearInterruptStatus(&hrTimerInstance, status);
+
+	const UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+	const uint64_t now = HrGetTimeInternal();
+	for (int i = 0; i < configPSI_HRTIMER_MAX_WAITERS; i++) {
+		if ((NULL != hrWaiters[i].task) && !hrWaiters[i].deferred && (hrWaiters[i].deadline <= now)) {
+			//If the task is not yet blocked, the deadline stays pending and is retried (also if
+			//..the timer command queue is full)
+			const BaseType_t result = xTaskAbortDelayFromISR(hrWaiters[i].task, &higherPrioWoken);
+			if (pdPASS == result) {
+				hrWaiters[i].deadline = HRTIMER_DEADLINE_DONE;
+			}
+			else if ((tskABORT_DELAY_EVENT_WAIT == result) &&
+					 (pdPASS == xTimerPendFunctionCallFromISR(HrAbortDeferred, NULL, (uint32_t)i, &higherPrioWoken))) {
+				hrWaiters[i].deferred = true;
+			}
+		}
+	}
+	HrArm(now);
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+	portYIELD_FROM_ISR(higherPrioWoken);
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+void PsiFreeRTOS_HrTimerInit() {
+	int iStatus;
+	XTtcPs_Config* pxTimerConfig = XTtcPs_LookupConfig( configPSI_TIMER_HRTIMER_ID );
+	iStatus = XTtcPs_CfgInitialize( &hrTimerInstance, pxTimerConfig, pxTimerConfig->BaseAddress );
+
+	if( iStatus != XST_SUCCESS )
+	{
+		XTtcPs_Stop(&hrTimerInstance);
+		iStatus = XTtcPs_CfgInitialize( &hrTimerInstance, pxTimerConfig, pxTimerConfig->BaseAddress );
+		if( iStatus != XST_SUCCESS )
+		{
+			printfInt( "In %s: Timer Cfg initialization failed...\r\n", __func__ );
+			return;
+		}
+	}
+
+	//Free running counter without prescaler, match 0 is used for the deadlines
+	XTtcPs_SetOptions( &hrTimerInstance, XTTCPS_OPTION_MATCH_MODE | XTTCPS_OPTION_WAVE_DISABLE );
+	countsPerUs = pxTimerConfig->InputClockHz / 1000000;
+	countsPerTick = (uint64_t)countsPerUs * (1000000 / configTICK_RATE_HZ);
+	retryCounts = PsiFreeRTOS_HrTimerUsToCounts(configPSI_HRTIMER_RETRY_US);
+	timeHigh = 0;
+	timeLastLow = 0;
+	for (int i = 0; i < configPSI_HRTIMER_MAX_WAITERS; i++) {
+		hrWaiters[i].task = NULL;
+		hrWaiters[i].deadline = HRTIMER_DEADLINE_DONE;
+		hrWaiters[i].deferred = false;
+	}
+
+	//Install interrupt with the configured priority (keep trigger type)
+	uint8_t prio, trigger;
+	xPortInstallInterruptHandler( configPSI_TIMER_HRTIMER_INTR, HrTimerIsr, NULL );
+	XScuGic_GetPriorityTriggerType( PsiFreeRTOS_GetXScuGic(), configPSI_TIMER_HRTIMER_INTR, &prio, &trigger );
+	XScuGic_SetPriorityTriggerType( PsiFreeRTOS_GetXScuGic(), configPSI_TIMER_HRTIMER_INTR,
+									configPSI_HRTIMER_IRQ_PRIORITY << portPRIORITY_SHIFT, trigger );
+	vPortEnableInterrupt( configPSI_TIMER_HRTIMER_INTR );
+	XTtcPs_EnableInterrupts( &hrTimerInstance, XTTCPS_IXR_CNT_OVR_MASK );
+	XTtcPs_Start( &hrTimerInstance );
+}
+
+uint64_t PsiFreeRTOS_HrTimerGetTime() {
+	const UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+	const uint64_t now = HrGetTimeInternal();
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+	return now;
+}
+
+uint64_t PsiFreeRTOS_HrTimerUsToCounts(uint32_t us) {
+	return (uint64_t)us * countsPerUs;
+}
+
+PsiFreeRTOS_HrTimeout PsiFreeRTOS_HrTimeoutStart(uint64_t deadline) {
+	PsiFreeRTOS_HrTimeout slot = -1;
+	taskENTER_CRITICAL();
+	for (int i = 0; i < configPSI_HRTIMER_MAX_WAITERS; i++) {
+		if (NULL == hrWaiters[i].task) {
+			slot = i;
+			hrWaiters[i].task = xGetCurrentTaskHandle();
+			hrWaiters[i].deadline = deadline;
+			hrWaiters[i].deferred = false;
+			HrArm(HrGetTimeInternal());
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+	//If no slot is free, -1 is returned and the blocking call falls back to tick resolution
+	return slot;
+}
+
+void PsiFreeRTOS_HrTimeoutStop(PsiFreeRTOS_HrTimeout timeout) {
+	if (timeout < 0) {
+		return;
+	}
+	taskENTER_CRITICAL();
+	hrWaiters[timeout].task = NULL;
+	hrWaiters[timeout].deadline = HRTIMER_DEADLINE_DONE;
+	hrWaiters[timeout].deferred = false;
+	//If the blocking call returned for another reason at the same time, the abort must not
+	//..affect the next blocking call of the task.
+	vTaskResetDelayAborted();
+	taskEXIT_CRITICAL();
+}
+
+TickType_t PsiFreeRTOS_HrTimerTicksUntil(uint64_t deadline) {
+	const uint64_t now = PsiFreeRTOS_HrTimerGetTime();
+	if (deadline <= now) {
+		return 0;
+	}
+	//One tick for rounding up and one for the partially elapsed current tick
+	const uint64_t ticks = (deadline - now) / countsPerTick + 2;
+	if (ticks >= portMAX_DELAY) {
+		return portMAX_DELAY - 1;
+	}
+	return (TickType_t)ticks;
+}
+
+void PsiFreeRTOS_DelayUs(uint32_t us) {
+	PsiFreeRTOS_DelayUntil(PsiFreeRTOS_HrTimerGetTime() + PsiFreeRTOS_HrTimerUsToCounts(us));
+}
+
+void PsiFreeRTOS_DelayUntil(uint64_t deadline) {
+	const uint64_t minBlock = PsiFreeRTOS_HrTimerUsToCounts(configPSI_HRTIMER_MIN_BLOCK_US);
+	if (deadline > PsiFreeRTOS_HrTimerGetTime() + minBlock) {
+		const PsiFreeRTOS_HrTimeout timeout = PsiFreeRTOS_HrTimeoutStart(deadline);
+		vTaskDelay(PsiFreeRTOS_HrTimerTicksUntil(deadline));
+		PsiFreeRTOS_HrTimeoutStop(timeout);
+	}
+	//Busy wait for short delays
+	while (PsiFreeRTOS_HrTimerGetTime() < deadline) {}
+}
+
+BaseType_t PsiFreeRTOS_QueueReceiveUs(QueueHandle_t queue_p, void* buffer_p, uint32_t us) {
+	const uint64_t deadline = PsiFreeRTOS_HrTimerGetTime() + PsiFreeRTOS_HrTimerUsToCounts(us);
+	//Poll for short timeouts
+	if (us < configPSI_HRTIMER_MIN_BLOCK_US) {
+		do {
+			if (pdTRUE == xQueueReceive(queue_p, buffer_p, 0)) {
+				return pdTRUE;
+			}
+		} while (PsiFreeRTOS_HrTimerGetTime() < deadline);
+		return pdFALSE;
+	}
+	const PsiFreeRTOS_HrTimeout timeout = PsiFreeRTOS_HrTimeoutStart(deadline);
+	const BaseType_t result = xQueueReceive(queue_p, buffer_p, PsiFreeRTOS_HrTimerTicksUntil(deadline));
+	PsiFreeRTOS_HrTimeoutStop(timeout);
+	return result;
+}
+
+BaseType_t PsiFreeRTOS_SemaphoreTakeUs(SemaphoreHandle_t semaphore_p, uint32_t us) {
+	const uint64_t deadline = PsiFreeRTOS_HrTimerGetTime() + PsiFreeRTOS_HrTimerUsToCounts(us);
+	//Poll for short timeouts
+	if (us < configPSI_HRTIMER_MIN_BLOCK_US) {
+		do {
+			if (pdTRUE == xSemaphoreTake(semaphore_p, 0)) {
+				return pdTRUE;
+			}
+		} while (PsiFreeRTOS_HrTimerGetTime() < deadline);
+		return pdFALSE;
+	}
+	const PsiFreeRTOS_HrTimeout timeout = PsiFreeRTOS_HrTimeoutStart(deadline);
+	const BaseType_t result = xSemaphoreTake(semaphore_p, PsiFreeRTOS_HrTimerTicksUntil(deadline));
+	PsiFreeRTOS_HrTimeoutStop(timeout);
+	return result;
+}
+
+#endif
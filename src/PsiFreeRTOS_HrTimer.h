@@ -0,0 +1,118 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include <stdint.h>
+
+#if (configPSI_USE_HRTIMER == 1)
+
+/*******************************************************************************************
+ * Types
+ *******************************************************************************************/
+/**
+ * @brief	Handle of an armed high resolution timeout (see PsiFreeRTOS_HrTimeoutStart())
+ */
+typedef int16_t PsiFreeRTOS_HrTimeout;
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Initialize the high resolution timer. This function is called by PsiFreeRTOS_Init()
+ * 			and must not be called by the user.
+ */
+void PsiFreeRTOS_HrTimerInit();
+
+/**
+ * @brief	Get the current time of the high resolution timer
+ *
+ * @return	Time in timer counts since PsiFreeRTOS_HrTimerInit() was called
+ */
+uint64_t PsiFreeRTOS_HrTimerGetTime();
+
+/**
+ * @brief	Convert microseconds into high resolution timer counts
+ *
+ * @param 	us		Time in microseconds
+ * @return			Time in timer counts
+ */
+uint64_t PsiFreeRTOS_HrTimerUsToCounts(uint32_t us);
+
+/**
+ * @brief	Arm a timeout that aborts the next blocking FreeRTOS call of the calling task when
+ * 			the absolute deadline is reached. The blocking call must use a finite timeout of at
+ * 			least PsiFreeRTOS_HrTimerTicksUntil(deadline) ticks, which acts as fallback.
+ * 			After the blocking call returned, PsiFreeRTOS_HrTimeoutStop() must be called.
+ *
+ * @param 	deadline	Absolute deadline in timer counts
+ * @return				Timeout handle or -1 if no timeout slot is available (the blocking call
+ * 						then only has tick resolution)
+ */
+PsiFreeRTOS_HrTimeout PsiFreeRTOS_HrTimeoutStart(uint64_t deadline);
+
+/**
+ * @brief	Release a timeout armed with PsiFreeRTOS_HrTimeoutStart()
+ *
+ * @param 	timeout		Handle returned by PsiFreeRTOS_HrTimeoutStart()
+ */
+void PsiFreeRTOS_HrTimeoutStop(PsiFreeRTOS_HrTimeout timeout);
+
+/**
+ * @brief	Calculate the fallback block time for a blocking call that waits until a deadline
+ *
+ * @param 	deadline	Absolute deadline in timer counts
+ * @return				Number of ticks that is guaranteed to reach beyond the deadline
+ */
+TickType_t PsiFreeRTOS_HrTimerTicksUntil(uint64_t deadline);
+
+/**
+ * @brief	Delay the calling task with microsecond resolution
+ *
+ * @param 	us		Delay in microseconds
+ */
+void PsiFreeRTOS_DelayUs(uint32_t us);
+
+/**
+ * @brief	Delay the calling task until an absolute deadline is reached
+ *
+ * @param 	deadline	Absolute deadline in timer counts (see PsiFreeRTOS_HrTimerGetTime())
+ */
+void PsiFreeRTOS_DelayUntil(uint64_t deadline);
+
+/**
+ * @brief	Same as xQueueReceive() but with a timeout in microseconds
+ *
+ * @param	queue_p		Queue to receive from
+ * @param	buffer_p	Buffer to copy the received item into
+ * @param 	us			Timeout in microseconds
+ * @return				pdTRUE if an item was received, pdFALSE on timeout
+ */
+BaseType_t PsiFreeRTOS_QueueReceiveUs(QueueHandle_t queue_p, void* buffer_p, uint32_t us);
+
+/**
+ * @brief	Same as xSemaphoreTake() but with a timeout in microseconds
+ *
+ * @param	semaphore_p	Semaphore to take
+ * @param 	us			Timeout in microseconds
+ * @return				pdTRUE if the semaphore was taken, pdFALSE on timeout
+ */
+BaseType_t PsiFreeRTOS_SemaphoreTakeUs(SemaphoreHandle_t semaphore_p, uint32_t us);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
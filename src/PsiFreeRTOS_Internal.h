@@ -0,0 +1,24 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+//Helpers shared between the PsiFreeRTOS modules, not intended to be used by the application
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS.h"
+
+/*******************************************************************************************
+ * Macros
+ *******************************************************************************************/
+//Print without the print mutex if unsafe (interrupt context or crash analysis), otherwise locked
+#define printfSel(unsafe, ...) { \
+	if (unsafe) { \
+		printfInt(__VA_ARGS__); \
+	} \
+	else { \
+		PsiFreeRTOS_printf(__VA_ARGS__); \
+	}}
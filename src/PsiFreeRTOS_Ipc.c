@@ -0,0 +1,143 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_Ipc.h"
+#include "PsiFreeRTOS_IpcRing.h"
+#include "PsiFreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "semphr.h"
+#include "xipipsu.h"
+#include "xscugic.h"
+#include <xparameters.h>
+
+#if (configPSI_USE_IPC == 1)
+
+#ifndef configPSI_IPC_IPI_ID
+	#error configPSI_IPC_IPI_ID must be defined when configPSI_USE_IPC is 1
+#endif
+
+#ifndef configPSI_IPC_IPI_INTR
+	#error configPSI_IPC_IPI_INTR must be defined when configPSI_USE_IPC is 1
+#endif
+
+#ifndef configPSI_IPC_PEER_IPI_MASK
+	#error configPSI_IPC_PEER_IPI_MASK must be defined when configPSI_USE_IPC is 1
+#endif
+
+#if ((configPSI_IPC_SHMEM_SIZE & (configPSI_IPC_SHMEM_SIZE - 1)) != 0) || ((configPSI_IPC_SHMEM_BASE & (configPSI_IPC_SHMEM_SIZE - 1)) != 0)
+	#error configPSI_IPC_SHMEM_SIZE must be a power of two and configPSI_IPC_SHMEM_BASE must be aligned to it
+#endif
+
+/*******************************************************************************************
+ * Private Variables
+ *******************************************************************************************/
+static XIpiPsu ipiInstance;
+static PsiFreeRTOS_IpcRing* rxRing_p;
+static PsiFreeRTOS_IpcRing* txRing_p;
+static SemaphoreHandle_t rxSemaphore;
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+//The shared memory is split in two halves, each core receives from the half of its index
+static PsiFreeRTOS_IpcRing* IpcRingOfCore(const uint32_t core) {
+	return (PsiFreeRTOS_IpcRing*)(configPSI_IPC_SHMEM_BASE + core*(configPSI_IPC_SHMEM_SIZE/2));
+}
+
+static void IpcIsr(void* arg_p) {
+	BaseType_t higherPrioWoken = pdFALSE;
+	const uint32_t status = XIpiPsu_GetInterruptStatus(&ipiInstance);
+	XIpiPsu_ClearInterruptStatus(&ipiInstance, status);
+	if (0 != (status & configPSI_IPC_PEER_IPI_MASK)) {
+		xSemaphoreGiveFromISR(rxSemaphore, &higherPrioWoken);
+	}
+	portYIELD_FROM_ISR(higherPrioWoken);
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+void PsiFreeRTOS_IpcInit() {
+	const uint32_t core = ulPortGetCoreID();
+	configASSERT(PsiFreeRTOS_IpcRingBytes(configPSI_IPC_ITEM_SIZE, configPSI_IPC_QUEUE_LENGTH) <= configPSI_IPC_SHMEM_SIZE/2);
+
+	//The RPU caches are not coherent, hence the shared memory is mapped non-cacheable
+	vPortSetMpuRegion(configPSI_IPC_MPU_REGION, configPSI_IPC_SHMEM_BASE, configPSI_IPC_SHMEM_SIZE, portMPU_ACCESS_RW_SHARED_NONCACHED);
+	rxRing_p = IpcRingOfCore(core);
+	txRing_p = IpcRingOfCore(1 - core);
+	rxSemaphore = xSemaphoreCreateBinary();
+
+	//IPI channel of this core
+	XIpiPsu_Config* ipiConfig_p = XIpiPsu_LookupConfig(configPSI_IPC_IPI_ID);
+	if (XST_SUCCESS != XIpiPsu_CfgInitialize(&ipiInstance, ipiConfig_p, ipiConfig_p->BaseAddress)) {
+		printfInt("In %s: IPI initialization failed...\r\n", __func__);
+		return;
+	}
+	XIpiPsu_ClearInterruptStatus(&ipiInstance, XIPIPSU_ALL_MASK);
+
+	//Install interrupt with the configured priority (keep trigger type)
+	uint8_t prio, trigger;
+	xPortInstallInterruptHandler(configPSI_IPC_IPI_INTR, IpcIsr, NULL);
+	XScuGic_GetPriorityTriggerType(PsiFreeRTOS_GetXScuGic(), configPSI_IPC_IPI_INTR, &prio, &trigger);
+	XScuGic_SetPriorityTriggerType(PsiFreeRTOS_GetXScuGic(), configPSI_IPC_IPI_INTR,
+								   configPSI_IPC_IRQ_PRIORITY << portPRIORITY_SHIFT, trigger);
+	vPortEnableInterrupt(configPSI_IPC_IPI_INTR);
+	XIpiPsu_InterruptEnable(&ipiInstance, XIPIPSU_ALL_MASK);
+
+	//The other core can send as soon as the receive ring is initialized
+	PsiFreeRTOS_IpcRingInit(rxRing_p, configPSI_IPC_ITEM_SIZE, configPSI_IPC_QUEUE_LENGTH);
+}
+
+bool PsiFreeRTOS_IpcPeerReady() {
+	return PsiFreeRTOS_IpcRingIsReady(txRing_p);
+}
+
+bool PsiFreeRTOS_IpcSend(const void* item_p) {
+	//Multiple tasks may send, the ring only supports one producer
+	taskENTER_CRITICAL();
+	const bool success = PsiFreeRTOS_IpcRingPush(txRing_p, item_p);
+	taskEXIT_CRITICAL();
+	if (success) {
+		XIpiPsu_TriggerIpi(&ipiInstance, configPSI_IPC_PEER_IPI_MASK);
+	}
+	return success;
+}
+
+bool PsiFreeRTOS_IpcSendFromISR(const void* item_p) {
+	const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+	const bool success = PsiFreeRTOS_IpcRingPush(txRing_p, item_p);
+	taskEXIT_CRITICAL_FROM_ISR(mask);
+	if (success) {
+		XIpiPsu_TriggerIpi(&ipiInstance, configPSI_IPC_PEER_IPI_MASK);
+	}
+	return success;
+}
+
+BaseType_t PsiFreeRTOS_IpcReceive(void* item_p, TickType_t timeout) {
+	TimeOut_t timeOut;
+	vTaskSetTimeOutState(&timeOut);
+	for (;;) {
+		//Multiple tasks may receive, the ring only supports one consumer
+		taskENTER_CRITICAL();
+		const bool success = PsiFreeRTOS_IpcRingPop(rxRing_p, item_p);
+		const bool more = (PsiFreeRTOS_IpcRingLevel(rxRing_p) > 0);
+		taskEXIT_CRITICAL();
+		if (success) {
+			//The IPI only wakes one receiver, pass on the notification if messages are left
+			if (more) {
+				xSemaphoreGive(rxSemaphore);
+			}
+			return pdTRUE;
+		}
+		if (pdFALSE != xTaskCheckForTimeOut(&timeOut, &timeout)) {
+			return pdFALSE;
+		}
+		xSemaphoreTake(rxSemaphore, timeout);
+	}
+}
+
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if (configPSI_USE_IPC == 1)
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Initialize the inter-core communication. This function is called by PsiFreeRTOS_Init()
+ * 			and must not be called by the user.
+ */
+void PsiFreeRTOS_IpcInit();
+
+/**
+ * @brief	Check if the other core initialized its receive queue (messages sent before are lost)
+ *
+ * @return	True if the other core is ready to receive messages
+ */
+bool PsiFreeRTOS_IpcPeerReady();
+
+/**
+ * @brief	Send a message to the other core. The function does not block.
+ *
+ * @param	item_p		Message to send (configPSI_IPC_ITEM_SIZE bytes)
+ * @return				True on success, false if the queue is full or the other core is not ready
+ */
+bool PsiFreeRTOS_IpcSend(const void* item_p);
+
+/**
+ * @brief	Same as PsiFreeRTOS_IpcSend() but to be called from interrupt context
+ *
+ * @param	item_p		Message to send (configPSI_IPC_ITEM_SIZE bytes)
+ * @return				True on success, false if the queue is full or the other core is not ready
+ */
+bool PsiFreeRTOS_IpcSendFromISR(const void* item_p);
+
+/**
+ * @brief	Receive a message from the other core
+ *
+ * @param	item_p		Buffer to copy the message into (configPSI_IPC_ITEM_SIZE bytes)
+ * @param	timeout		Maximum time to wait for a message in ticks
+ * @return				pdTRUE if a message was received, pdFALSE on timeout
+ */
+BaseType_t PsiFreeRTOS_IpcReceive(void* item_p, TickType_t timeout);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
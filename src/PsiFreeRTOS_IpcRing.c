@@ -0,0 +1,73 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_IpcRing.h"
+#include <string.h>
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+//Order the accesses to the shared memory (DMB on ARM). Data must be visible to the other
+//..side before the index is updated and the index must be read before the data.
+#define IpcBarrier() __sync_synchronize()
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+uint32_t PsiFreeRTOS_IpcRingBytes(uint32_t itemSize, uint32_t itemCount) {
+	return sizeof(PsiFreeRTOS_IpcRing) + itemSize*itemCount;
+}
+
+void PsiFreeRTOS_IpcRingInit(PsiFreeRTOS_IpcRing* ring_p, uint32_t itemSize, uint32_t itemCount) {
+	ring_p->magic = 0;
+	IpcBarrier();
+	ring_p->itemSize = itemSize;
+	ring_p->itemCount = itemCount;
+	ring_p->writeIdx = 0;
+	ring_p->readIdx = 0;
+	IpcBarrier();
+	ring_p->magic = PSI_IPC_RING_MAGIC;
+	IpcBarrier();
+}
+
+bool PsiFreeRTOS_IpcRingIsReady(const PsiFreeRTOS_IpcRing* ring_p) {
+	return PSI_IPC_RING_MAGIC == ring_p->magic;
+}
+
+bool PsiFreeRTOS_IpcRingPush(PsiFreeRTOS_IpcRing* ring_p, const void* item_p) {
+	if (!PsiFreeRTOS_IpcRingIsReady(ring_p)) {
+		return false;
+	}
+	IpcBarrier();
+	const uint32_t wr = ring_p->writeIdx;
+	if (wr - ring_p->readIdx >= ring_p->itemCount) {
+		return false;
+	}
+	IpcBarrier();
+	memcpy(&ring_p->data[(wr % ring_p->itemCount)*ring_p->itemSize], item_p, ring_p->itemSize);
+	IpcBarrier();
+	ring_p->writeIdx = wr + 1;
+	IpcBarrier();
+	return true;
+}
+
+bool PsiFreeRTOS_IpcRingPop(PsiFreeRTOS_IpcRing* ring_p, void* item_p) {
+	const uint32_t rd = ring_p->readIdx;
+	if (ring_p->writeIdx == rd) {
+		return false;
+	}
+	IpcBarrier();
+	memcpy(item_p, &ring_p->data[(rd % ring_p->itemCount)*ring_p->itemSize], ring_p->itemSize);
+	IpcBarrier();
+	ring_p->readIdx = rd + 1;
+	IpcBarrier();
+	return true;
+}
+
+uint32_t PsiFreeRTOS_IpcRingLevel(const PsiFreeRTOS_IpcRing* ring_p) {
+	return ring_p->writeIdx - ring_p->readIdx;
+}
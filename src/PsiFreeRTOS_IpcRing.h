@@ -0,0 +1,96 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+//This file does not depend on FreeRTOS or the Xilinx BSP, so the ring logic can also be
+//..compiled for a host (e.g. with two threads sharing the memory instead of two cores).
+
+/*******************************************************************************************
+ * Types
+ *******************************************************************************************/
+/**
+ * @brief	Single-producer single-consumer ring of fixed size items in shared memory. The
+ * 			ring is initialized by the consumer, the producer only writes writeIdx and the
+ * 			consumer only writes readIdx. Indexes are free running (wrap at 2^32).
+ */
+typedef struct {
+	volatile uint32_t magic;		//PSI_IPC_RING_MAGIC once initialized by the consumer
+	uint32_t itemSize;
+	uint32_t itemCount;
+	volatile uint32_t writeIdx;
+	volatile uint32_t readIdx;
+	uint8_t data[];
+} PsiFreeRTOS_IpcRing;
+
+#define PSI_IPC_RING_MAGIC	0x50534951
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Get the number of bytes of shared memory required for a ring
+ *
+ * @param	itemSize	Size of one item in bytes
+ * @param	itemCount	Number of items the ring can hold
+ * @return				Number of bytes required
+ */
+uint32_t PsiFreeRTOS_IpcRingBytes(uint32_t itemSize, uint32_t itemCount);
+
+/**
+ * @brief	Initialize a ring. Must be called by the consumer before the producer can push.
+ *
+ * @param	ring_p		Ring in shared memory
+ * @param	itemSize	Size of one item in bytes
+ * @param	itemCount	Number of items the ring can hold
+ */
+void PsiFreeRTOS_IpcRingInit(PsiFreeRTOS_IpcRing* ring_p, uint32_t itemSize, uint32_t itemCount);
+
+/**
+ * @brief	Check if the consumer initialized the ring
+ *
+ * @param	ring_p		Ring in shared memory
+ * @return				True if the ring is ready to be used
+ */
+bool PsiFreeRTOS_IpcRingIsReady(const PsiFreeRTOS_IpcRing* ring_p);
+
+/**
+ * @brief	Push an item (producer side)
+ *
+ * @param	ring_p		Ring in shared memory
+ * @param	item_p		Item to copy into the ring (itemSize bytes)
+ * @return				True on success, false if the ring is full or not initialized
+ */
+bool PsiFreeRTOS_IpcRingPush(PsiFreeRTOS_IpcRing* ring_p, const void* item_p);
+
+/**
+ * @brief	Pop an item (consumer side)
+ *
+ * @param	ring_p		Ring in shared memory
+ * @param	item_p		Buffer to copy the item into (itemSize bytes)
+ * @return				True on success, false if the ring is empty
+ */
+bool PsiFreeRTOS_IpcRingPop(PsiFreeRTOS_IpcRing* ring_p, void* item_p);
+
+/**
+ * @brief	Get the number of items in the ring
+ *
+ * @param	ring_p		Ring in shared memory
+ * @return				Number of items that can be popped
+ */
+uint32_t PsiFreeRTOS_IpcRingLevel(const PsiFreeRTOS_IpcRing* ring_p);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,140 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_IrqGuard.h"
+#include "PsiFreeRTOS.h"
+#include "PsiFreeRTOS_Internal.h"
+#include "FreeRTOSConfig.h"
+#include "xscugic.h"
+
+#if (configPSI_USE_IRQ_GUARD == 1)
+
+/*******************************************************************************************
+ * Private Variables
+ *******************************************************************************************/
+static volatile uint32_t irqCount[XSCUGIC_MAX_NUM_INTR_INPUTS];
+static uint32_t irqRate[XSCUGIC_MAX_NUM_INTR_INPUTS];
+static uint32_t irqLimit[XSCUGIC_MAX_NUM_INTR_INPUTS];
+static uint32_t irqStorms[XSCUGIC_MAX_NUM_INTR_INPUTS];
+static PsiFreeRTOS_IrqStormHandler stormHandler_p;
+//The storm is only recorded in the interrupt and reported from task context
+static volatile uint32_t stormCount;
+static volatile uint32_t lastStormIrq;
+static volatile TickType_t lastStormTick;
+static TickType_t periodTicks;
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+static void IrqGuardPrintInternal(bool isIrqContext) {
+	printfSel(isIrqContext, "PsiFreeRTOS Interrupts [per %d ticks]:\r\n", configPSI_IRQ_GUARD_PERIOD_TICKS);
+	printfSel(isIrqContext, "%-6s %10s %10s %10s %8s\r\n", "IRQ", "LastRate", "Current", "Limit", "Storms");
+	for (uint32_t i = 0; i < XSCUGIC_MAX_NUM_INTR_INPUTS; i++) {
+		if ((0 == irqRate[i]) && (0 == irqCount[i]) && (0 == irqStorms[i])) {
+			continue;
+		}
+		printfSel(isIrqContext, "%-6d %10d %10d %10d %8d\r\n", i, irqRate[i], irqCount[i], irqLimit[i], irqStorms[i]);
+	}
+	if (0 != stormCount) {
+		printfSel(isIrqContext, "ERROR: %d interrupt storms, last: interrupt %d disabled at tick %d\r\n",
+				  stormCount, lastStormIrq, lastStormTick);
+	}
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+void PsiFreeRTOS_IrqGuardInit() {
+	for (uint32_t i = 0; i < XSCUGIC_MAX_NUM_INTR_INPUTS; i++) {
+		irqCount[i] = 0;
+		irqRate[i] = 0;
+		irqLimit[i] = configPSI_IRQ_GUARD_DEFAULT_LIMIT;
+		irqStorms[i] = 0;
+	}
+	//The tick is never limited
+	irqLimit[configTIMER_INTERRUPT_ID] = 0;
+	stormHandler_p = NULL;
+	stormCount = 0;
+	lastStormIrq = 0;
+	lastStormTick = 0;
+	periodTicks = 0;
+}
+
+//The counter is also checked in the interrupt, so a storm starving the tick is detected too
+portTCM_CODE bool PsiFreeRTOS_IrqGuardCheck(uint32_t irqId) {
+	const uint32_t count = irqCount[irqId] + 1;
+	irqCount[irqId] = count;
+	const uint32_t limit = irqLimit[irqId];
+	if ((0 == limit) || (count <= limit)) {
+		return true;
+	}
+	vPortDisableInterrupt(irqId);
+	irqStorms[irqId]++;
+	lastStormIrq = irqId;
+	lastStormTick = xTaskGetTickCountFromISR();
+	stormCount++;
+	if (NULL != stormHandler_p) {
+		(*stormHandler_p)(irqId);
+	}
+	return false;
+}
+
+void PsiFreeRTOS_IrqGuardTick() {
+	periodTicks++;
+	if (periodTicks < configPSI_IRQ_GUARD_PERIOD_TICKS) {
+		return;
+	}
+	periodTicks = 0;
+	//Interrupts above configMAX_API_CALL_INTERRUPT_PRIORITY can increment the counter in
+	//..between, so it is read and cleared atomically
+	for (uint32_t i = 0; i < XSCUGIC_MAX_NUM_INTR_INPUTS; i++) {
+		irqRate[i] = __atomic_exchange_n(&irqCount[i], 0, __ATOMIC_RELAXED);
+	}
+}
+
+void PsiFreeRTOS_IrqGuardSetLimit(uint32_t irqId, uint32_t maxPerPeriod) {
+	configASSERT(irqId < XSCUGIC_MAX_NUM_INTR_INPUTS);
+	irqLimit[irqId] = maxPerPeriod;
+}
+
+void PsiFreeRTOS_IrqGuardSetHandler(PsiFreeRTOS_IrqStormHandler handler_p) {
+	stormHandler_p = handler_p;
+}
+
+uint32_t PsiFreeRTOS_IrqGuardGetRate(uint32_t irqId) {
+	configASSERT(irqId < XSCUGIC_MAX_NUM_INTR_INPUTS);
+	return irqRate[irqId];
+}
+
+uint32_t PsiFreeRTOS_IrqGuardGetStorms(uint32_t irqId) {
+	configASSERT(irqId < XSCUGIC_MAX_NUM_INTR_INPUTS);
+	return irqStorms[irqId];
+}
+
+uint32_t PsiFreeRTOS_IrqGuardGetLastStorm(uint32_t* irqId_p, TickType_t* tick_p) {
+	//Read consistently, a storm of another interrupt may be recorded in between
+	taskENTER_CRITICAL();
+	const uint32_t count = stormCount;
+	if (NULL != irqId_p) {
+		*irqId_p = lastStormIrq;
+	}
+	if (NULL != tick_p) {
+		*tick_p = lastStormTick;
+	}
+	taskEXIT_CRITICAL();
+	return count;
+}
+
+void PsiFreeRTOS_IrqGuardPrint() {
+	IrqGuardPrintInternal(false);
+}
+
+void PsiFreeRTOS_IrqGuardPrintUnlocked() {
+	IrqGuardPrintInternal(true);
+}
+
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if (configPSI_USE_IRQ_GUARD == 1)
+
+/*******************************************************************************************
+ * Types
+ *******************************************************************************************/
+/**
+ * @brief	Function called when an interrupt exceeded its rate limit and was disabled. It is
+ * 			called from interrupt context and must not print (report from a task instead).
+ *
+ * @param	irqId	Interrupt ID
+ */
+typedef void (*PsiFreeRTOS_IrqStormHandler)(uint32_t irqId);
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Initialize the interrupt storm guard. This function is called by PsiFreeRTOS_Init()
+ * 			and must not be called by the user.
+ */
+void PsiFreeRTOS_IrqGuardInit();
+
+/**
+ * @brief	Count an interrupt and disable it if it exceeded its rate limit. This function is
+ * 			called by vApplicationIRQHandler() and must not be called by the user.
+ *
+ * @param	irqId	Interrupt ID
+ * @return			True if the interrupt handler shall be called, false if it was disabled
+ */
+bool PsiFreeRTOS_IrqGuardCheck(uint32_t irqId);
+
+/**
+ * @brief	Evaluate the rate counters. This function is called by the tick hook and must not
+ * 			be called by the user.
+ */
+void PsiFreeRTOS_IrqGuardTick();
+
+/**
+ * @brief	Set the rate limit of an interrupt
+ *
+ * @param	irqId			Interrupt ID
+ * @param	maxPerPeriod	Maximum number of interrupts per configPSI_IRQ_GUARD_PERIOD_TICKS
+ * 							(0 = no limit)
+ */
+void PsiFreeRTOS_IrqGuardSetLimit(uint32_t irqId, uint32_t maxPerPeriod);
+
+/**
+ * @brief	Register a function that is called when an interrupt storm is detected
+ *
+ * @param	handler_p	Function to call (NULL = none)
+ */
+void PsiFreeRTOS_IrqGuardSetHandler(PsiFreeRTOS_IrqStormHandler handler_p);
+
+/**
+ * @brief	Get the number of interrupts in the last complete period
+ *
+ * @param	irqId	Interrupt ID
+ * @return			Interrupts per configPSI_IRQ_GUARD_PERIOD_TICKS
+ */
+uint32_t PsiFreeRTOS_IrqGuardGetRate(uint32_t irqId);
+
+/**
+ * @brief	Get the number of times an interrupt was disabled by the guard
+ *
+ * @param	irqId	Interrupt ID
+ * @return			Number of interrupt storms detected
+ */
+uint32_t PsiFreeRTOS_IrqGuardGetStorms(uint32_t irqId);
+
+/**
+ * @brief	Get the last interrupt disabled by the guard. The guard does not print from
+ * 			interrupt context, tasks can poll this function to report storms.
+ *
+ * @param	irqId_p		Output: ID of the last disabled interrupt (may be NULL)
+ * @param	tick_p		Output: Tick count when it was disabled (may be NULL)
+ * @return				Total number of interrupt storms detected (0 = none, outputs invalid)
+ */
+uint32_t PsiFreeRTOS_IrqGuardGetLastStorm(uint32_t* irqId_p, TickType_t* tick_p);
+
+/**
+ * @brief	Print the rates of all active interrupts to the console
+ */
+void PsiFreeRTOS_IrqGuardPrint();
+
+/**
+ * @brief	Same as PsiFreeRTOS_IrqGuardPrint() but without locking the print mutex. This
+ * 			function is used by PsiFreeRTOS for the crash analysis and must not be called by the user.
+ */
+void PsiFreeRTOS_IrqGuardPrintUnlocked();
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,167 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_TimeSync.h"
+#include "PsiFreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "timers.h"
+#include "xil_io.h"
+
+#if (configPSI_USE_TIMESYNC == 1)
+
+#if (!configGENERATE_RUN_TIME_STATS)
+	#error configGENERATE_RUN_TIME_STATS must be 1 when configPSI_USE_TIMESYNC is 1
+#endif
+
+#if (configUSE_TIMERS != 1)
+	#error configUSE_TIMERS must be 1 when configPSI_USE_TIMESYNC is 1
+#endif
+
+/*******************************************************************************************
+ * Private Types and Constants
+ *******************************************************************************************/
+//Linear model: global = globalRef + (local - localRef) * rate
+typedef struct {
+	uint64_t localRef;
+	uint64_t globalRef;
+	uint64_t rateQ32;		//Global counts per local count (32 fractional bits)
+	bool valid;
+} SyncModel;
+
+//IOU_SCNTRS registers
+#define SYSCNT_COUNT_LOW_OFFSET		0x08
+#define SYSCNT_COUNT_HIGH_OFFSET	0x0C
+#define SYSCNT_FREQ_OFFSET			0x20
+
+/*******************************************************************************************
+ * Private Variables
+ *******************************************************************************************/
+static SyncModel model;
+static uint32_t globalFreqHz;
+static TimerHandle_t syncTimer;
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+//Calculate value*ratio without overflowing for large values
+static uint64_t MulQ32(const uint64_t value, const uint64_t ratioQ32) {
+	const uint64_t rInt = ratioQ32 >> 32;
+	const uint64_t rFrac = ratioQ32 & 0xFFFFFFFFULL;
+	return value*rInt + (value >> 32)*rFrac + (((value & 0xFFFFFFFFULL)*rFrac) >> 32);
+}
+
+//Calculate num/den with 32 fractional bits (reduces precision if num is large)
+static uint64_t RatioQ32(const uint64_t num, const uint64_t den) {
+	uint32_t shift = 32;
+	while ((shift > 0) && (num >= (1ULL << (64 - shift)))) {
+		shift--;
+	}
+	return ((num << shift) / den) << (32 - shift);
+}
+
+//Rate expected from the nominal frequencies (the time base frequency is only known after
+//..the scheduler is started)
+static uint64_t NominalRateQ32() {
+	return RatioQ32(globalFreqHz, PsiFreeRTOS_TimeGetFreqHz());
+}
+
+//Take a local and global timestamp at the same time (the local time is the middle of the
+//..global counter read)
+static void TimeSyncSample(uint64_t* local_p, uint64_t* global_p) {
+	const UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+	const uint64_t before = PsiFreeRTOS_TimeGet();
+	*global_p = PsiFreeRTOS_TimeSyncGetGlobal();
+	const uint64_t after = PsiFreeRTOS_TimeGet();
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+	*local_p = before + (after - before)/2;
+}
+
+static void TimeSyncCallback(TimerHandle_t timer_p) {
+	uint64_t local, global;
+	TimeSyncSample(&local, &global);
+
+	taskENTER_CRITICAL();
+	if (model.valid && (local > model.localRef)) {
+		const uint64_t measured = RatioQ32(global - model.globalRef, local - model.localRef);
+		if (0 == model.rateQ32) {
+			model.rateQ32 = measured;
+		}
+		else {
+			//Average the drift over multiple periods to suppress the sampling jitter
+			model.rateQ32 += ((int64_t)(measured - model.rateQ32)) >> configPSI_TIMESYNC_DRIFT_FILTER_SHIFT;
+		}
+	}
+	model.localRef = local;
+	model.globalRef = global;
+	model.valid = true;
+	taskEXIT_CRITICAL();
+
+	//The first synchronization is done as soon as possible
+	if (xTimerGetPeriod(timer_p) != configPSI_TIMESYNC_PERIOD_TICKS) {
+		xTimerChangePeriod(timer_p, configPSI_TIMESYNC_PERIOD_TICKS, 0);
+	}
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+void PsiFreeRTOS_TimeSyncInit() {
+	globalFreqHz = Xil_In32(configPSI_TIMESYNC_SYSCNT_BASEADDR + SYSCNT_FREQ_OFFSET);
+	model.valid = false;
+	model.rateQ32 = 0;
+	syncTimer = xTimerCreate("PsiTimeSync", 1, pdTRUE, NULL, TimeSyncCallback);
+	xTimerStart(syncTimer, 0);
+}
+
+uint64_t PsiFreeRTOS_TimeSyncGetGlobal() {
+	uint32_t high, low;
+	do {
+		high = Xil_In32(configPSI_TIMESYNC_SYSCNT_BASEADDR + SYSCNT_COUNT_HIGH_OFFSET);
+		low = Xil_In32(configPSI_TIMESYNC_SYSCNT_BASEADDR + SYSCNT_COUNT_LOW_OFFSET);
+	} while (high != Xil_In32(configPSI_TIMESYNC_SYSCNT_BASEADDR + SYSCNT_COUNT_HIGH_OFFSET));
+	return ((uint64_t)high << 32) | low;
+}
+
+uint32_t PsiFreeRTOS_TimeSyncGetGlobalFreqHz() {
+	return globalFreqHz;
+}
+
+bool PsiFreeRTOS_TimeSyncValid() {
+	return model.valid;
+}
+
+uint64_t PsiFreeRTOS_TimeToGlobal(uint64_t localTime) {
+	const UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+	const SyncModel m = model;
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+	if (!m.valid) {
+		return 0;
+	}
+	//Before the drift is known, the nominal rate is used
+	uint64_t rate = m.rateQ32;
+	if (0 == rate) {
+		rate = NominalRateQ32();
+	}
+	if (localTime >= m.localRef) {
+		return m.globalRef + MulQ32(localTime - m.localRef, rate);
+	}
+	else {
+		return m.globalRef - MulQ32(m.localRef - localTime, rate);
+	}
+}
+
+int32_t PsiFreeRTOS_TimeSyncGetDriftPpb() {
+	if ((0 == model.rateQ32) || (0 == globalFreqHz)) {
+		return 0;
+	}
+	const uint64_t nominal = NominalRateQ32();
+	const int64_t diff = (int64_t)(model.rateQ32 - nominal);
+	return (int32_t)((diff * 1000000000LL) / (int64_t)nominal);
+}
+
+#endif
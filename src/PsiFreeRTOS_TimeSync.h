@@ -0,0 +1,70 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if (configPSI_USE_TIMESYNC == 1)
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Initialize the time synchronization. This function is called by PsiFreeRTOS_Init()
+ * 			and must not be called by the user.
+ */
+void PsiFreeRTOS_TimeSyncInit();
+
+/**
+ * @brief	Read the system timestamp generator (the global time used by the APU)
+ *
+ * @return	Global time in system counter counts
+ */
+uint64_t PsiFreeRTOS_TimeSyncGetGlobal();
+
+/**
+ * @brief	Get the frequency of the system timestamp generator
+ *
+ * @return	System counter counts per second (as configured by the FSBL)
+ */
+uint32_t PsiFreeRTOS_TimeSyncGetGlobalFreqHz();
+
+/**
+ * @brief	Check if the synchronization model is valid (at least one synchronization was done)
+ *
+ * @return	True if PsiFreeRTOS_TimeToGlobal() can be used
+ */
+bool PsiFreeRTOS_TimeSyncValid();
+
+/**
+ * @brief	Convert a PsiFreeRTOS time base value into global time. The function can be called
+ * 			from tasks and interrupts, also for timestamps taken in the past.
+ *
+ * @param 	localTime	Time from PsiFreeRTOS_TimeGet()
+ * @return				Global time in system counter counts (0 if the model is not yet valid)
+ */
+uint64_t PsiFreeRTOS_TimeToGlobal(uint64_t localTime);
+
+/**
+ * @brief	Get the measured drift of the PsiFreeRTOS time base against the system counter
+ *
+ * @return	Drift in parts per billion (positive = local timer runs slower than nominal)
+ */
+int32_t PsiFreeRTOS_TimeSyncGetDriftPpb();
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,192 @@
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "PsiFreeRTOS_WorkQueue.h"
+#include "PsiFreeRTOS.h"
+#include "FreeRTOSConfig.h"
+
+#if (configPSI_USE_WORKQUEUE == 1)
+
+#if (!configGENERATE_RUN_TIME_STATS)
+	#error configGENERATE_RUN_TIME_STATS must be 1 when configPSI_USE_WORKQUEUE is 1
+#endif
+
+/*******************************************************************************************
+ * Private Types and Constants
+ *******************************************************************************************/
+struct PsiFreeRTOS_WorkQueue {
+	TaskHandle_t task;			//NULL = slot free
+	const char* name;
+	PsiFreeRTOS_Work* head_p;
+	PsiFreeRTOS_Work* tail_p;
+	uint32_t executed;
+	uint32_t rejected;
+	uint64_t latencySum;
+	uint64_t latencyMax;
+};
+
+/*******************************************************************************************
+ * Private Variables
+ *******************************************************************************************/
+static PsiFreeRTOS_WorkQueue workQueues[configPSI_WORKQUEUE_MAX_QUEUES];
+
+/*******************************************************************************************
+ * Private Helper Functions
+ *******************************************************************************************/
+//Must be called with interrupts masked
+static bool WorkEnqueue(PsiFreeRTOS_WorkQueue* queue_p, PsiFreeRTOS_Work* work_p) {
+	if (work_p->pending) {
+		queue_p->rejected++;
+		return false;
+	}
+	work_p->pending = true;
+	work_p->next_p = NULL;
+	work_p->submitTime = PsiFreeRTOS_TimeGet();
+	if (NULL == queue_p->tail_p) {
+		queue_p->head_p = work_p;
+	}
+	else {
+		queue_p->tail_p->next_p = work_p;
+	}
+	queue_p->tail_p = work_p;
+	return true;
+}
+
+//Must be called with interrupts masked. The work item can be resubmitted as soon as it is removed.
+static PsiFreeRTOS_Work* WorkDequeue(PsiFreeRTOS_WorkQueue* queue_p) {
+	PsiFreeRTOS_Work* work_p = queue_p->head_p;
+	if (NULL != work_p) {
+		queue_p->head_p = work_p->next_p;
+		if (NULL == queue_p->head_p) {
+			queue_p->tail_p = NULL;
+		}
+		work_p->pending = false;
+	}
+	return work_p;
+}
+
+static void WorkQueueTask(void* arg_p) {
+	PsiFreeRTOS_WorkQueue* queue_p = (PsiFreeRTOS_WorkQueue*)arg_p;
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		for (;;) {
+			taskENTER_CRITICAL();
+			PsiFreeRTOS_Work* work_p = WorkDequeue(queue_p);
+			const uint64_t now = PsiFreeRTOS_TimeGet();
+			if (NULL != work_p) {
+				const uint64_t latency = now - work_p->submitTime;
+				queue_p->executed++;
+				queue_p->latencySum += latency;
+				if (latency > queue_p->latencyMax) {
+					queue_p->latencyMax = latency;
+				}
+			}
+			taskEXIT_CRITICAL();
+			if (NULL == work_p) {
+				break;
+			}
+			//The work item may be resubmitted (or reused) by the function, so copy it first
+			const PsiFreeRTOS_WorkFunction function_p = work_p->function_p;
+			void* const workArg_p = work_p->arg_p;
+			function_p(workArg_p);
+		}
+	}
+}
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+void PsiFreeRTOS_WorkInit(PsiFreeRTOS_Work* work_p, PsiFreeRTOS_WorkFunction function_p, void* arg_p) {
+	work_p->next_p = NULL;
+	work_p->function_p = function_p;
+	work_p->arg_p = arg_p;
+	work_p->submitTime = 0;
+	work_p->pending = false;
+}
+
+PsiFreeRTOS_WorkQueue* PsiFreeRTOS_WorkQueueCreate(const char* name, UBaseType_t priority, uint16_t stackDepth) {
+	//Find free slot
+	PsiFreeRTOS_WorkQueue* queue_p = NULL;
+	taskENTER_CRITICAL();
+	for (int i = 0; i < configPSI_WORKQUEUE_MAX_QUEUES; i++) {
+		if (NULL == workQueues[i].task) {
+			queue_p = &workQueues[i];
+			//Reserve the slot until the task is created
+			queue_p->task = (TaskHandle_t)queue_p;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+	if (NULL == queue_p) {
+		return NULL;
+	}
+
+	//Initialize queue
+	queue_p->name = name;
+	queue_p->head_p = NULL;
+	queue_p->tail_p = NULL;
+	queue_p->executed = 0;
+	queue_p->rejected = 0;
+	queue_p->latencySum = 0;
+	queue_p->latencyMax = 0;
+	TaskHandle_t task;
+	if (pdPASS != xTaskCreate(WorkQueueTask, name, stackDepth, queue_p, priority, &task)) {
+		queue_p->task = NULL;
+		return NULL;
+	}
+	queue_p->task = task;
+	return queue_p;
+}
+
+bool PsiFreeRTOS_WorkSubmit(PsiFreeRTOS_WorkQueue* queue_p, PsiFreeRTOS_Work* work_p) {
+	taskENTER_CRITICAL();
+	const bool success = WorkEnqueue(queue_p, work_p);
+	taskEXIT_CRITICAL();
+	if (success) {
+		xTaskNotifyGive(queue_p->task);
+	}
+	return success;
+}
+
+bool PsiFreeRTOS_WorkSubmitFromISR(PsiFreeRTOS_WorkQueue* queue_p, PsiFreeRTOS_Work* work_p, BaseType_t* higherPrioWoken_p) {
+	const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+	const bool success = WorkEnqueue(queue_p, work_p);
+	taskEXIT_CRITICAL_FROM_ISR(mask);
+	if (success) {
+		vTaskNotifyGiveFromISR(queue_p->task, higherPrioWoken_p);
+	}
+	return success;
+}
+
+void PsiFreeRTOS_WorkQueueGetStats(PsiFreeRTOS_WorkQueue* queue_p, PsiFreeRTOS_WorkQueueStats* stats_p) {
+	taskENTER_CRITICAL();
+	const uint32_t executed = queue_p->executed;
+	const uint32_t rejected = queue_p->rejected;
+	const uint64_t latencySum = queue_p->latencySum;
+	const uint64_t latencyMax = queue_p->latencyMax;
+	taskEXIT_CRITICAL();
+	stats_p->executed = executed;
+	stats_p->rejected = rejected;
+	stats_p->latencyAvgUs = (0 == executed) ? 0 : (uint32_t)PsiFreeRTOS_TimeToUs(latencySum / executed);
+	stats_p->latencyMaxUs = (uint32_t)PsiFreeRTOS_TimeToUs(latencyMax);
+}
+
+void PsiFreeRTOS_WorkQueuePrintStats() {
+	PsiFreeRTOS_printf("PsiFreeRTOS Work Queues [us]:\r\n");
+	PsiFreeRTOS_printf("%-20s %10s %10s %10s %10s\r\n", "Name", "Executed", "Rejected", "AvgLat", "MaxLat");
+	for (int i = 0; i < configPSI_WORKQUEUE_MAX_QUEUES; i++) {
+		if (NULL == workQueues[i].task) {
+			continue;
+		}
+		PsiFreeRTOS_WorkQueueStats stats;
+		PsiFreeRTOS_WorkQueueGetStats(&workQueues[i], &stats);
+		PsiFreeRTOS_printf("%-20s %10d %10d %10d %10d\r\n", workQueues[i].name,
+							stats.executed, stats.rejected, stats.latencyAvgUs, stats.latencyMaxUs);
+	}
+}
+
+#endif
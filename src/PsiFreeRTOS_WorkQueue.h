@@ -0,0 +1,118 @@
+#pragma once
+
+/*******************************************************************************************
+ * Copyright (c) 2019 Paul Scherrer Institute, Oliver Bründler
+ *******************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************************
+ * Includes
+ *******************************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if (configPSI_USE_WORKQUEUE == 1)
+
+/*******************************************************************************************
+ * Types
+ *******************************************************************************************/
+/**
+ * @brief	Function executed by a work queue
+ */
+typedef void (*PsiFreeRTOS_WorkFunction)(void* arg_p);
+
+/**
+ * @brief	Work item. Work items are allocated by the user and are not copied when they are
+ * 			submitted, so they must stay valid until they are executed. The members must only
+ * 			be accessed through the functions below.
+ */
+typedef struct PsiFreeRTOS_Work {
+	struct PsiFreeRTOS_Work* next_p;
+	PsiFreeRTOS_WorkFunction function_p;
+	void* arg_p;
+	uint64_t submitTime;
+	volatile bool pending;
+} PsiFreeRTOS_Work;
+
+/**
+ * @brief	Work queue handle (see PsiFreeRTOS_WorkQueueCreate())
+ */
+typedef struct PsiFreeRTOS_WorkQueue PsiFreeRTOS_WorkQueue;
+
+/**
+ * @brief	Statistics of a work queue
+ */
+typedef struct {
+	uint32_t executed;			//Number of work items executed
+	uint32_t rejected;			//Number of submits rejected because the work item was still pending
+	uint32_t latencyAvgUs;		//Average time from submit to start of execution
+	uint32_t latencyMaxUs;		//Maximum time from submit to start of execution
+} PsiFreeRTOS_WorkQueueStats;
+
+/*******************************************************************************************
+ * Public Functions
+ *******************************************************************************************/
+/**
+ * @brief	Initialize a work item
+ *
+ * @param	work_p		Work item to initialize
+ * @param	function_p	Function to execute
+ * @param	arg_p		Argument passed to the function
+ */
+void PsiFreeRTOS_WorkInit(PsiFreeRTOS_Work* work_p, PsiFreeRTOS_WorkFunction function_p, void* arg_p);
+
+/**
+ * @brief	Create a work queue with its own worker task. Work items are executed in the order
+ * 			they are submitted at the priority of the worker task.
+ *
+ * @param	name		Name of the worker task
+ * @param	priority	Priority of the worker task
+ * @param	stackDepth	Stack size of the worker task in words
+ * @return				Work queue handle, NULL if configPSI_WORKQUEUE_MAX_QUEUES queues exist already
+ * 						or the task cannot be created
+ */
+PsiFreeRTOS_WorkQueue* PsiFreeRTOS_WorkQueueCreate(const char* name, UBaseType_t priority, uint16_t stackDepth);
+
+/**
+ * @brief	Submit a work item to a work queue
+ *
+ * @param	queue_p		Work queue
+ * @param	work_p		Work item to execute
+ * @return				True on success, false if the work item is still pending (it is executed
+ * 						only once in this case)
+ */
+bool PsiFreeRTOS_WorkSubmit(PsiFreeRTOS_WorkQueue* queue_p, PsiFreeRTOS_Work* work_p);
+
+/**
+ * @brief	Same as PsiFreeRTOS_WorkSubmit() but to be called from interrupt context
+ *
+ * @param	queue_p				Work queue
+ * @param	work_p				Work item to execute
+ * @param	higherPrioWoken_p	Set to pdTRUE if a context switch is required (see portYIELD_FROM_ISR())
+ * @return						True on success, false if the work item is still pending
+ */
+bool PsiFreeRTOS_WorkSubmitFromISR(PsiFreeRTOS_WorkQueue* queue_p, PsiFreeRTOS_Work* work_p, BaseType_t* higherPrioWoken_p);
+
+/**
+ * @brief	Get the statistics of a work queue
+ *
+ * @param	queue_p		Work queue
+ * @param	stats_p		Statistics output
+ */
+void PsiFreeRTOS_WorkQueueGetStats(PsiFreeRTOS_WorkQueue* queue_p, PsiFreeRTOS_WorkQueueStats* stats_p);
+
+/**
+ * @brief	Print the statistics of all work queues to the console
+ */
+void PsiFreeRTOS_WorkQueuePrintStats();
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
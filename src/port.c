@@ -65,9 +65,10 @@
 #endif
 
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
-	/* Check the configuration. */
-	#if( configMAX_PRIORITIES > 32 )
-		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	/* Check the configuration.  PSI specific: more than 32 priorities use a two
+	level bit map (see portmacro.h). */
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
 	#endif
 #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
@@ -139,6 +140,8 @@ the CPU itself before modifying certain hardware registers. */
 }
 
 #define portINTERRUPT_PRIORITY_REGISTER_OFFSET		0x400UL
+#define portINTERRUPT_TARGET_REGISTER_OFFSET		0x800UL
+#define portFIRST_SHARED_INTERRUPT_ID				32UL
 #define portMAX_8_BIT_VALUE							( ( uint8_t ) 0xff )
 #define portBIT_0_SET								( ( uint8_t ) 0x01 )
 
@@ -171,7 +174,7 @@ variable has to be stored as part of the task context and must be initialised to
 a non zero value to ensure interrupts don't inadvertently become unmasked before
 the scheduler starts.  As it is stored as part of the task context it will
 automatically be set to 0 when the first task is started. */
-volatile uint32_t ulCriticalNesting = 9999UL;
+portTCM_DATA volatile uint32_t ulCriticalNesting = 9999UL;
 
 /* 
  * The instance of the interrupt controller used by this port.  This is required
@@ -181,14 +184,38 @@ extern XScuGic xInterruptController;
 
 /* Saved as part of the task context.  If ulPortTaskHasFPUContext is non-zero then
 a floating point context must be saved and restored for the task. */
-uint32_t ulPortTaskHasFPUContext = pdFALSE;
+portTCM_DATA uint32_t ulPortTaskHasFPUContext = pdFALSE;
 
 /* Set to 1 to pend a context switch from an ISR. */
-uint32_t ulPortYieldRequired = pdFALSE;
+portTCM_DATA uint32_t ulPortYieldRequired = pdFALSE;
+
+/* PSI specific: one bit per interrupt ID, set for handlers that use the FPU. */
+portTCM_DATA uint32_t ulPortFpuInterrupts[ portFPU_INTERRUPT_WORDS ] = { 0 };
+
+/* PSI specific: number of FPU interrupt handlers currently executing. */
+portTCM_DATA volatile uint32_t ulPortFpuInterruptNesting = 0UL;
+
+#if( configPSI_USE_TICK_STATS == 1 )
+	/* PSI specific: tick timer value at the entry of FreeRTOS_Tick_Handler(). */
+	portTCM_DATA volatile uint32_t ulPortTickEntryCount = 0UL;
+#endif
+
+#if( configPSI_USE_EXCEPTION_STACK_STATS == 1 )
+	/* PSI specific: updated by vApplicationIRQHandler(). */
+	portTCM_DATA uint32_t ulPortInterruptNestingMax = 0UL;
+#endif
+
+/* PSI specific: implemented in portASM.S. */
+extern void vPortFpuSafeCall( XInterruptHandler pxHandler, void *pvCallBackRef );
 
 /* Counts the interrupt nesting depth.  A context switch is only performed if
 if the nesting depth is 0. */
-uint32_t ulPortInterruptNesting = 0UL;
+portTCM_DATA uint32_t ulPortInterruptNesting = 0UL;
+
+#if( configPSI_USE_MPU_STACK_GUARD == 1 )
+	/* PSI specific: base address of the stack guard currently programmed. */
+	portTCM_DATA volatile uint32_t ulPortStackGuardBase = 0UL;
+#endif
 
 /* Used in asm code. */
 __attribute__(( used )) const uint32_t ulICCIAR = portICCIAR_INTERRUPT_ACKNOWLEDGE_REGISTER_ADDRESS;
@@ -310,6 +337,9 @@ int32_t lReturn;
 	if( lReturn == XST_SUCCESS )
 	{
 		lReturn = pdPASS;
+
+		/* PSI specific: the handler is called without FPU preservation. */
+		ulPortFpuInterrupts[ ucInterruptID >> 5 ] &= ~( 1UL << ( ucInterruptID & 0x1FUL ) );
 	}
 	configASSERT( lReturn == pdPASS );
 
@@ -317,6 +347,43 @@ int32_t lReturn;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xPortInstallFpuInterruptHandler( uint8_t ucInterruptID, XInterruptHandler pxHandler, void *pvCallBackRef )
+{
+BaseType_t xReturn;
+
+	xReturn = xPortInstallInterruptHandler( ucInterruptID, pxHandler, pvCallBackRef );
+	if( xReturn == pdPASS )
+	{
+		ulPortFpuInterrupts[ ucInterruptID >> 5 ] |= ( 1UL << ( ucInterruptID & 0x1FUL ) );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portTCM_CODE void vPortCallFpuInterruptHandler( XInterruptHandler pxHandler, void *pvCallBackRef )
+{
+	/* The nesting count is incremented in any case because the handler
+	itself leaves live FPU registers behind if it is interrupted. */
+	ulPortFpuInterruptNesting++;
+
+	#if( configUSE_TASK_FPU_SUPPORT == 1 )
+	if( ( ulPortTaskHasFPUContext == pdFALSE ) && ( ulPortFpuInterruptNesting == 1UL ) )
+	{
+		/* Neither the interrupted task nor an interrupted handler uses the
+		FPU, so there is nothing to preserve. */
+		pxHandler( pvCallBackRef );
+	}
+	else
+	#endif
+	{
+		vPortFpuSafeCall( pxHandler, pvCallBackRef );
+	}
+
+	ulPortFpuInterruptNesting--;
+}
+/*-----------------------------------------------------------*/
+
 static int32_t prvEnsureInterruptControllerIsInitialised( void )
 {
 static int32_t lInterruptControllerInitialised = pdFALSE;
@@ -381,12 +448,29 @@ int32_t lReturn;
 	lReturn = prvEnsureInterruptControllerIsInitialised();
 	if( lReturn == pdPASS )
 	{
+		vPortRouteInterruptToThisCore( ucInterruptID );
 		XScuGic_Enable( &xInterruptController, ucInterruptID );
 	}	
 	configASSERT( lReturn );
 }
 /*-----------------------------------------------------------*/
 
+void vPortRouteInterruptToThisCore( uint8_t ucInterruptID )
+{
+volatile uint8_t *pucTargetRegister;
+
+	/* PSI specific: SGIs and PPIs are banked per core, only shared peripheral
+	interrupts have a target register.  The target is replaced (not ORed) because
+	the GIC driver of the core that initialized the distributor first routes all
+	shared interrupts to that core. */
+	if( ucInterruptID >= portFIRST_SHARED_INTERRUPT_ID )
+	{
+		pucTargetRegister = ( volatile uint8_t * ) ( configINTERRUPT_CONTROLLER_BASE_ADDRESS + portINTERRUPT_TARGET_REGISTER_OFFSET + ucInterruptID );
+		*pucTargetRegister = ( uint8_t ) ( 1UL << ulPortGetCoreID() );
+	}
+}
+/*-----------------------------------------------------------*/
+
 void vPortDisableInterrupt( uint8_t ucInterruptID )
 {
 int32_t lReturn;
@@ -495,7 +579,7 @@ void vPortEndScheduler( void )
 }
 /*-----------------------------------------------------------*/
 
-void vPortEnterCritical( void )
+portTCM_CODE void vPortEnterCritical( void )
 {
 	/* Mask interrupts up to the max syscall interrupt priority. */
 	ulPortSetInterruptMask();
@@ -517,7 +601,7 @@ void vPortEnterCritical( void )
 }
 /*-----------------------------------------------------------*/
 
-void vPortExitCritical( void )
+portTCM_CODE void vPortExitCritical( void )
 {
 	if( ulCriticalNesting > portNO_CRITICAL_NESTING )
 	{
@@ -537,8 +621,15 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
-void FreeRTOS_Tick_Handler( void )
+portTCM_CODE void FreeRTOS_Tick_Handler( void )
 {
+	/* PSI specific: sample the tick timer as early as possible. */
+	#if( configPSI_USE_TICK_STATS == 1 )
+	{
+		ulPortTickEntryCount = *pulPortTickTimerCounter;
+	}
+	#endif
+
 	/* Set interrupt mask before altering scheduler structures.   The tick
 	handler runs at the lowest priority, so interrupts cannot already be masked,
 	so there is no need to save and restore the current mask value.  It is
@@ -562,6 +653,120 @@ void FreeRTOS_Tick_Handler( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configPSI_USE_MPU_STACK_GUARD == 1 )
+
+	/* PSI specific: must be called with interrupts masked.  The region is only
+	ever moved between stacks of tasks that are not running. */
+	portTCM_CODE void vPortSetStackGuard( StackType_t *pxStack )
+	{
+	uint32_t ulBase = portSTACK_GUARD_BASE( pxStack );
+
+		ulPortStackGuardBase = ulBase;
+		vPortSetMpuRegion( configPSI_MPU_STACK_GUARD_REGION, ulBase, configPSI_MPU_STACK_GUARD_SIZE, portMPU_ACCESS_NONE_WRITE_BACK );
+	}
+
+#endif /* configPSI_USE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
+#if( configPSI_USE_EXCEPTION_STACK_STATS == 1 )
+
+	/* PSI specific: stacks defined in the Xilinx linker script.  The stacks
+	grow down from __xxx_stack to _xxx_stack_end. */
+	extern uint32_t _stack_end[], _stack[];
+	extern uint32_t _irq_stack_end[], __irq_stack[];
+	extern uint32_t _supervisor_stack_end[], __supervisor_stack[];
+	extern uint32_t _abort_stack_end[], __abort_stack[];
+	extern uint32_t _fiq_stack_end[], __fiq_stack[];
+	extern uint32_t _undef_stack_end[], __undef_stack[];
+
+	#define portSTACK_PAINT_VALUE		0xA5A5A5A5UL
+
+	/* Words not painted below the current stack pointer (for the frame of
+	the painting function). */
+	#define portSTACK_PAINT_MARGIN		64UL
+
+	static uint32_t * const pulExceptionStackLow[ portEXCEPTION_STACK_COUNT ] =
+		{ _stack_end, _irq_stack_end, _supervisor_stack_end, _abort_stack_end, _fiq_stack_end, _undef_stack_end };
+	static uint32_t * const pulExceptionStackHigh[ portEXCEPTION_STACK_COUNT ] =
+		{ _stack, __irq_stack, __supervisor_stack, __abort_stack, __fiq_stack, __undef_stack };
+	static const char * const pcExceptionStackName[ portEXCEPTION_STACK_COUNT ] =
+		{ "<System Stack>", "<IRQ Stack>", "<SVC Stack>", "<Abort Stack>", "<FIQ Stack>", "<Undef Stack>" };
+
+	/* Number of painted words at the bottom of each stack found by the last
+	check.  The value can only decrease, so later checks stop there. */
+	static uint32_t ulExceptionStackFree[ portEXCEPTION_STACK_COUNT ] = { 0 };
+
+	void vPortPaintExceptionStacks( void )
+	{
+	uint32_t ulIndex;
+	uint32_t ulCPSR;
+	uint32_t *pulWord;
+	uint32_t *pulEnd;
+	uint32_t ulSP;
+
+		/* No exception must use the stacks while they are painted. */
+		__asm volatile ( "MRS %0, cpsr" : "=r" ( ulCPSR ) :: "memory" );
+		__asm volatile ( "CPSID if" ::: "memory" );
+		__asm volatile ( "MOV %0, sp" : "=r" ( ulSP ) );
+
+		for( ulIndex = 0; ulIndex < portEXCEPTION_STACK_COUNT; ulIndex++ )
+		{
+			pulEnd = pulExceptionStackHigh[ ulIndex ];
+
+			/* The stack in use (usually the system mode stack of main()) is
+			only painted below the current stack pointer. */
+			if( ( ulSP > ( uint32_t ) pulExceptionStackLow[ ulIndex ] ) && ( ulSP <= ( uint32_t ) pulEnd ) )
+			{
+				pulEnd = ( uint32_t * ) ulSP - portSTACK_PAINT_MARGIN;
+				if( pulEnd < pulExceptionStackLow[ ulIndex ] )
+				{
+					pulEnd = pulExceptionStackLow[ ulIndex ];
+				}
+			}
+
+			for( pulWord = pulExceptionStackLow[ ulIndex ]; pulWord < pulEnd; pulWord++ )
+			{
+				*pulWord = portSTACK_PAINT_VALUE;
+			}
+			ulExceptionStackFree[ ulIndex ] = ( uint32_t ) ( pulEnd - pulExceptionStackLow[ ulIndex ] );
+		}
+
+		__asm volatile ( "MSR cpsr_c, %0" :: "r" ( ulCPSR ) : "memory" );
+	}
+	/*-----------------------------------------------------------*/
+
+	const char *pcPortGetExceptionStackName( uint32_t ulIndex )
+	{
+		configASSERT( ulIndex < portEXCEPTION_STACK_COUNT );
+		return pcExceptionStackName[ ulIndex ];
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortGetExceptionStackSize( uint32_t ulIndex )
+	{
+		configASSERT( ulIndex < portEXCEPTION_STACK_COUNT );
+		return ( uint32_t ) ( pulExceptionStackHigh[ ulIndex ] - pulExceptionStackLow[ ulIndex ] );
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortGetExceptionStackHighWaterMark( uint32_t ulIndex )
+	{
+	const uint32_t *pulLow;
+	uint32_t ulFree = 0UL;
+
+		configASSERT( ulIndex < portEXCEPTION_STACK_COUNT );
+		pulLow = pulExceptionStackLow[ ulIndex ];
+		while( ( ulFree < ulExceptionStackFree[ ulIndex ] ) && ( pulLow[ ulFree ] == portSTACK_PAINT_VALUE ) )
+		{
+			ulFree++;
+		}
+		ulExceptionStackFree[ ulIndex ] = ulFree;
+		return ulFree;
+	}
+
+#endif /* configPSI_USE_EXCEPTION_STACK_STATS */
+/*-----------------------------------------------------------*/
+
 void vPortTaskUsesFPU( void )
 {
 uint32_t ulInitialFPSCR = 0;
@@ -575,7 +780,7 @@ uint32_t ulInitialFPSCR = 0;
 }
 /*-----------------------------------------------------------*/
 
-void vPortClearInterruptMask( uint32_t ulNewMaskValue )
+portTCM_CODE void vPortClearInterruptMask( uint32_t ulNewMaskValue )
 {
 	if( ulNewMaskValue == pdFALSE )
 	{
@@ -584,7 +789,7 @@ void vPortClearInterruptMask( uint32_t ulNewMaskValue )
 }
 /*-----------------------------------------------------------*/
 
-uint32_t ulPortSetInterruptMask( void )
+portTCM_CODE uint32_t ulPortSetInterruptMask( void )
 {
 uint32_t ulReturn;
 
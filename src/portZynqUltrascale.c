@@ -36,6 +36,10 @@
 #include "xscugic.h"
 #include "xttcps.h"
 
+#if( configPSI_USE_IRQ_GUARD == 1 )
+	#include "PsiFreeRTOS_IrqGuard.h"
+#endif
+
 /*
  * Some FreeRTOSConfig.h settings require the application writer to provide the
  * implementation of a callback function that has a specific name, and a linker
@@ -55,6 +59,18 @@ void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName ) __att
 /* Timer used to generate the tick interrupt. */
 static XTtcPs xTimerInstance;
 XScuGic xInterruptController;
+
+#if( configPSI_USE_FAST_TICK == 1 )
+	/* PSI specific: interrupt status register of the tick timer, accessed directly
+	to acknowledge the tick. */
+	static volatile uint32_t *pulTickTimerStatus;
+#endif
+
+#if( configPSI_USE_TICK_STATS == 1 )
+	/* PSI specific: see portmacro.h. */
+	volatile uint32_t *pulPortTickTimerCounter;
+	uint32_t ulPortTickInterval;
+#endif
 /*-----------------------------------------------------------*/
 
 void FreeRTOS_SetupTickInterrupt( void )
@@ -100,11 +116,23 @@ XScuGic_Config *pxInterruptControllerConfig;
 			return;
 		}
 	}
+	#if( configPSI_USE_FAST_TICK == 1 )
+	{
+		pulTickTimerStatus = ( volatile uint32_t * ) ( pxTimerConfig->BaseAddress + XTTCPS_ISR_OFFSET );
+	}
+	#endif
 	XTtcPs_SetOptions( &xTimerInstance, XTTCPS_OPTION_INTERVAL_MODE | XTTCPS_OPTION_WAVE_DISABLE );
 	XTtcPs_CalcIntervalFromFreq( &xTimerInstance, configTICK_RATE_HZ, &usInterval, &ucPrescaler );
 	XTtcPs_SetInterval( &xTimerInstance, usInterval );
+	#if( configPSI_USE_TICK_STATS == 1 )
+	{
+		pulPortTickTimerCounter = ( volatile uint32_t * ) ( pxTimerConfig->BaseAddress + XTTCPS_COUNT_VALUE_OFFSET );
+		ulPortTickInterval = usInterval;
+	}
+	#endif
 	XTtcPs_SetPrescaler( &xTimerInstance, ucPrescaler );
 	/* Enable the interrupt for timer. */
+	vPortRouteInterruptToThisCore( configTIMER_INTERRUPT_ID ); /* PSI specific: split mode */
 	XScuGic_EnableIntr( configINTERRUPT_CONTROLLER_BASE_ADDRESS, configTIMER_INTERRUPT_ID );
 	XTtcPs_EnableInterrupts( &xTimerInstance, XTTCPS_IXR_INTERVAL_MASK );
 	XTtcPs_Start( &xTimerInstance );
@@ -112,16 +140,27 @@ XScuGic_Config *pxInterruptControllerConfig;
 }
 /*-----------------------------------------------------------*/
 
-void FreeRTOS_ClearTickInterrupt( void )
+portTCM_CODE void FreeRTOS_ClearTickInterrupt( void )
 {
 uint32_t ulStatusEvent;
 
-	ulStatusEvent = XTtcPs_GetInterruptStatus( &xTimerInstance );
-	XTtcPs_ClearInterruptStatus( &xTimerInstance, ulStatusEvent );
+	#if( configPSI_USE_FAST_TICK == 1 )
+	{
+		/* PSI specific: same as the driver calls below without the instance
+		lookups. */
+		ulStatusEvent = *pulTickTimerStatus;
+		*pulTickTimerStatus = ulStatusEvent;
+	}
+	#else
+	{
+		ulStatusEvent = XTtcPs_GetInterruptStatus( &xTimerInstance );
+		XTtcPs_ClearInterruptStatus( &xTimerInstance, ulStatusEvent );
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
-void vApplicationIRQHandler( uint32_t ulICCIAR )
+portTCM_CODE void vApplicationIRQHandler( uint32_t ulICCIAR )
 {
 extern const XScuGic_Config XScuGic_ConfigTable[];
 static const XScuGic_VectorTableEntry *pxVectorTable = XScuGic_ConfigTable[ XPAR_SCUGIC_SINGLE_DEVICE_ID ].HandlerTable;
@@ -131,12 +170,54 @@ const XScuGic_VectorTableEntry *pxVectorEntry;
 	/* The ID of the interrupt is obtained by bitwise ANDing the ICCIAR value
 	with 0x3FF. */
 	ulInterruptID = ulICCIAR & 0x3FFUL;
+
+	/* PSI specific: record the maximum nesting depth. */
+	#if( configPSI_USE_EXCEPTION_STACK_STATS == 1 )
+	{
+		if( ulPortInterruptNesting > ulPortInterruptNestingMax )
+		{
+			ulPortInterruptNestingMax = ulPortInterruptNesting;
+		}
+	}
+	#endif
+
+	#if( configPSI_USE_FAST_TICK == 1 )
+	{
+		/* PSI specific: the tick is handled without the table dispatch. */
+		if( ulInterruptID == configTIMER_INTERRUPT_ID )
+		{
+			FreeRTOS_Tick_Handler();
+			return;
+		}
+	}
+	#endif
+
 	if( ulInterruptID < XSCUGIC_MAX_NUM_INTR_INPUTS )
 	{
 		/* Call the function installed in the array of installed handler
 		functions. */
 		pxVectorEntry = &( pxVectorTable[ ulInterruptID ] );
-		pxVectorEntry->Handler( pxVectorEntry->CallBackRef );
+
+		/* PSI specific: interrupts exceeding their rate limit are disabled. */
+		#if( configPSI_USE_IRQ_GUARD == 1 )
+		{
+			if( PsiFreeRTOS_IrqGuardCheck( ulInterruptID ) == false )
+			{
+				return;
+			}
+		}
+		#endif
+
+		/* PSI specific: handlers that use the FPU are called through a wrapper
+		preserving the FPU registers. */
+		if( ( ulPortFpuInterrupts[ ulInterruptID >> 5UL ] & ( 1UL << ( ulInterruptID & 0x1FUL ) ) ) != 0UL )
+		{
+			vPortCallFpuInterruptHandler( pxVectorEntry->Handler, pxVectorEntry->CallBackRef );
+		}
+		else
+		{
+			pxVectorEntry->Handler( pxVectorEntry->CallBackRef );
+		}
 	}
 }
 /*-----------------------------------------------------------*/
@@ -170,6 +170,53 @@ void vPortEnableInterrupt( uint8_t ucInterruptID );
  */
 void vPortDisableInterrupt( uint8_t ucInterruptID );
 
+/*
+ * PSI specific: same as xPortInstallInterruptHandler() but for handlers that
+ * use the FPU.  The FPU registers are saved and restored around the handler
+ * (only if the interrupted task or handler can have live FPU registers).
+ * Handlers installed with xPortInstallInterruptHandler() must not use the FPU,
+ * they are called without any additional cost.
+ */
+BaseType_t xPortInstallFpuInterruptHandler( uint8_t ucInterruptID, XInterruptHandler pxHandler, void *pvCallBackRef );
+
+/* PSI specific: used by vApplicationIRQHandler() to dispatch FPU handlers. */
+#define portFPU_INTERRUPT_WORDS		( 256 / 32 )
+extern uint32_t ulPortFpuInterrupts[ portFPU_INTERRUPT_WORDS ];
+void vPortCallFpuInterruptHandler( XInterruptHandler pxHandler, void *pvCallBackRef );
+
+#if( configPSI_USE_EXCEPTION_STACK_STATS == 1 )
+	/* PSI specific: high water marks of the stacks defined in the linker script
+	(system mode stack used by main(), IRQ, supervisor, abort, FIQ and undefined
+	mode stacks).  The stacks are painted by vPortPaintExceptionStacks(), the
+	high water mark is the number of words never used since. */
+	#define portEXCEPTION_STACK_COUNT	6
+	void vPortPaintExceptionStacks( void );
+	const char *pcPortGetExceptionStackName( uint32_t ulIndex );
+	uint32_t ulPortGetExceptionStackSize( uint32_t ulIndex );
+	uint32_t ulPortGetExceptionStackHighWaterMark( uint32_t ulIndex );
+
+	/* PSI specific: maximum interrupt nesting depth observed. */
+	extern uint32_t ulPortInterruptNesting;
+	extern uint32_t ulPortInterruptNestingMax;
+#endif
+
+#if( configPSI_USE_TICK_STATS == 1 )
+	/* PSI specific: the tick timer counts up from 0 to ulPortTickInterval and
+	raises the tick interrupt when it restarts.  Its value at the entry of
+	FreeRTOS_Tick_Handler() is the lateness of the tick interrupt. */
+	extern volatile uint32_t *pulPortTickTimerCounter;
+	extern uint32_t ulPortTickInterval;
+	extern volatile uint32_t ulPortTickEntryCount;
+#endif
+
+/*
+ * PSI specific: routes the interrupt specified by ucInterruptID to the core
+ * executing the function.  In split mode both RPU cores share the GIC, this
+ * function is called by vPortEnableInterrupt() so an interrupt is always handled
+ * by the core that enabled it.
+ */
+void vPortRouteInterruptToThisCore( uint8_t ucInterruptID );
+
 /* Any task that uses the floating point unit MUST call vPortTaskUsesFPU()
 before any floating point instructions are executed. */
 void vPortTaskUsesFPU( void );
@@ -183,7 +230,7 @@ void vPortTaskUsesFPU( void );
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
 #endif
 
-#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES <= 32 )
 
 	/* Store/clear the ready priorities in a bit map. */
 	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
@@ -193,6 +240,38 @@ void vPortTaskUsesFPU( void );
 
 	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __builtin_clz( uxReadyPriorities ) )
 
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	/* PSI specific: two level bit map for more than 32 priorities.  Each bit of
+	uxReadyPriorities marks a group of 32 priorities containing ready tasks, the
+	ready priorities of group n are stored in uxReadyPriorities##Groups[ n ]
+	(defined in tasks.c).  The highest priority is found with two CLZ. */
+	#define portREADY_PRIORITY_GROUPS ( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )								\
+	{																								\
+		uxReadyPriorities##Groups[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 0x1FUL ) );	\
+		( uxReadyPriorities ) |= ( 1UL << ( ( uxPriority ) >> 5 ) );								\
+	}
+
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )								\
+	{																								\
+		uxReadyPriorities##Groups[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 0x1FUL ) );	\
+		if( uxReadyPriorities##Groups[ ( uxPriority ) >> 5 ] == 0UL )								\
+		{																							\
+			( uxReadyPriorities ) &= ~( 1UL << ( ( uxPriority ) >> 5 ) );							\
+		}																							\
+	}
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )							\
+	{																								\
+	const UBaseType_t uxGroup = 31 - __builtin_clz( uxReadyPriorities );							\
+																									\
+		uxTopPriority = ( uxGroup << 5 ) + ( 31 - __builtin_clz( uxReadyPriorities##Groups[ uxGroup ] ) ); \
+	}
+
 #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 #ifdef configASSERT
@@ -202,6 +281,70 @@ void vPortTaskUsesFPU( void );
 
 #define portNOP() __asm volatile( "NOP" )
 
+/* PSI specific: the kernel hot paths (context switch, tick, ready lists, queue
+fast paths) are placed into dedicated sections so a linker script can locate
+them in TCM.  The default linker script places them together with all other
+code and data because the names match *(.text.*) and *(.data.*). */
+#define portTCM_CODE __attribute__(( section( ".text.psi_tcm" ) ))
+#define portTCM_DATA __attribute__(( section( ".data.psi_tcm" ) ))
+
+/* PSI specific: index of the RPU core executing the code (0 = R5_0, 1 = R5_1,
+lockstep mode always returns 0), read from the affinity level 0 of the MPIDR. */
+static inline uint32_t ulPortGetCoreID( void )
+{
+uint32_t ulMPIDR;
+
+	__asm volatile ( "MRC	p15, 0, %0, c0, c0, 5" : "=r" ( ulMPIDR ) );
+	return ulMPIDR & 0xFFUL;
+}
+
+/* PSI specific: MPU region access control values (execute never).  The stack
+guard uses the memory type of the DDR the stacks are located in (normal, outer
+and inner write-back write-allocate: TEX = 001, C = 1, B = 1), memory shared
+between the RPU cores is normal, non-cacheable and shareable (TEX = 001, S = 1)
+because the RPU caches are not coherent. */
+#define portMPU_EXECUTE_NEVER				( 1UL << 12 )
+#define portMPU_ACCESS_NONE_WRITE_BACK		( portMPU_EXECUTE_NEVER | ( 0UL << 8 ) | ( 1UL << 3 ) | ( 1UL << 1 ) | ( 1UL << 0 ) )
+#define portMPU_ACCESS_RW_SHARED_NONCACHED	( portMPU_EXECUTE_NEVER | ( 3UL << 8 ) | ( 1UL << 3 ) | ( 1UL << 2 ) )
+
+/* PSI specific: program and enable one MPU region.  ulSize must be a power of
+two of at least 32 bytes and ulBase must be aligned to ulSize. */
+static inline void vPortSetMpuRegion( uint32_t ulRegion, uint32_t ulBase, uint32_t ulSize, uint32_t ulAccess )
+{
+uint32_t ulSizeEnable = ( ( uint32_t ) ( __builtin_ctz( ulSize ) - 1 ) << 1 ) | 1UL;
+
+	/* Select the region, then write base address, access control and size.
+	The size and enable bits are written last. */
+	__asm volatile ( "MCR	p15, 0, %0, c6, c2, 0" :: "r" ( ulRegion ) : "memory" );
+	__asm volatile ( "MCR	p15, 0, %0, c6, c1, 0" :: "r" ( ulBase ) : "memory" );
+	__asm volatile ( "MCR	p15, 0, %0, c6, c1, 4" :: "r" ( ulAccess ) : "memory" );
+	__asm volatile ( "MCR	p15, 0, %0, c6, c1, 2" :: "r" ( ulSizeEnable ) : "memory" );
+	__asm volatile (	"dsb		\n"
+						"isb		\n" ::: "memory" );
+}
+
+/* PSI specific: MPU stack guard.  One MPU region is reprogrammed on every
+context switch to cover the lowest configPSI_MPU_STACK_GUARD_SIZE bytes of the
+stack of the task being switched in (aligned upwards to the region size as
+required by the MPU) with no access.  A stack overflow therefore leads to a data
+abort instead of silently corrupting memory. */
+#if( configPSI_USE_MPU_STACK_GUARD == 1 )
+	#if( ( configPSI_MPU_STACK_GUARD_SIZE < 32 ) || ( ( configPSI_MPU_STACK_GUARD_SIZE & ( configPSI_MPU_STACK_GUARD_SIZE - 1 ) ) != 0 ) )
+		#error configPSI_MPU_STACK_GUARD_SIZE must be a power of two and at least 32
+	#endif
+
+	#define portSTACK_GUARD_BASE( pxStack )	( ( ( uint32_t ) ( pxStack ) + ( configPSI_MPU_STACK_GUARD_SIZE - 1UL ) ) & ~( configPSI_MPU_STACK_GUARD_SIZE - 1UL ) )
+	#define portSTACK_GUARD_END( pxStack )	( portSTACK_GUARD_BASE( pxStack ) + configPSI_MPU_STACK_GUARD_SIZE )
+
+	/* Stack words added to each task stack for the guard and its alignment. */
+	#define portSTACK_GUARD_WORDS			( ( 2UL * configPSI_MPU_STACK_GUARD_SIZE ) / sizeof( StackType_t ) )
+
+	/* Base address of the guard currently programmed into the MPU. */
+	extern volatile uint32_t ulPortStackGuardBase;
+
+	void vPortSetStackGuard( StackType_t *pxStack );
+#endif
+
 
 #ifdef __cplusplus
 	} /* extern C */
@@ -121,6 +121,11 @@ typedef struct QueueDefinition
 		uint8_t ucQueueType;
 	#endif
 
+	/* PSI specific: priority ceiling of a mutex (0 = priority inheritance). */
+	#if( configPSI_USE_CEILING_MUTEX == 1 )
+		UBaseType_t uxCeilingPriority;
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -464,6 +469,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.uxRecursiveCallCount = 0;
 
+			#if( configPSI_USE_CEILING_MUTEX == 1 )
+			{
+				pxNewQueue->uxCeilingPriority = ( UBaseType_t ) 0;
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
@@ -723,7 +734,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
+portTCM_CODE BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
 {
 BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
 TimeOut_t xTimeOut;
@@ -921,7 +932,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
+portTCM_CODE BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
@@ -1072,7 +1083,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+portTCM_CODE BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
@@ -1237,7 +1248,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+portTCM_CODE BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
@@ -1379,7 +1390,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+portTCM_CODE BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
@@ -1433,6 +1444,18 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->pxMutexHolder = ( int8_t * ) pvTaskIncrementMutexHeldCount(); /*lint !e961 Cast is not redundant as TaskHandle_t is a typedef. */
+
+						/* PSI specific: the holder of a ceiling mutex runs at
+						the ceiling priority until it gives back its last mutex
+						(see xTaskPriorityDisinherit()). */
+						#if( configPSI_USE_CEILING_MUTEX == 1 )
+						{
+							if( pxQueue->uxCeilingPriority != ( UBaseType_t ) 0 )
+							{
+								vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+							}
+						}
+						#endif
 					}
 					else
 					{
@@ -1516,7 +1539,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 				#if ( configUSE_MUTEXES == 1 )
 				{
-					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					/* PSI specific: the holder of a ceiling mutex already
+					runs at the ceiling, it does not inherit priorities. */
+					#if( configPSI_USE_CEILING_MUTEX == 1 )
+						if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->uxCeilingPriority == ( UBaseType_t ) 0 ) )
+					#else
+						if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					#endif
 					{
 						taskENTER_CRITICAL();
 						{
@@ -1748,7 +1777,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+portTCM_CODE BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
@@ -2038,7 +2067,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+portTCM_CODE static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
 {
 BaseType_t xReturn = pdFALSE;
 UBaseType_t uxMessagesWaiting;
@@ -2117,7 +2146,7 @@ UBaseType_t uxMessagesWaiting;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+portTCM_CODE static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
 {
 	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
 	{
@@ -2897,3 +2926,47 @@ BaseType_t xReturn;
 
 #endif /* configUSE_QUEUE_SETS */
 
+/*******************************************************************************************
+ * PSI SPECIFIC ADDITIONS
+ *******************************************************************************************/
+#if( configPSI_USE_CEILING_MUTEX == 1 )
+
+	#if( configUSE_MUTEXES != 1 )
+		#error configUSE_MUTEXES must be 1 when configPSI_USE_CEILING_MUTEX is 1
+	#endif
+
+	void vQueueSetMutexCeiling( QueueHandle_t xMutex, UBaseType_t uxCeilingPriority )
+	{
+	Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+		configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		taskENTER_CRITICAL();
+		{
+			/* The ceiling cannot be changed while the mutex is held. */
+			configASSERT( pxMutex->pxMutexHolder == NULL );
+			pxMutex->uxCeilingPriority = uxCeilingPriority;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+		QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType, UBaseType_t uxCeilingPriority )
+		{
+		QueueHandle_t xMutex;
+
+			xMutex = xQueueCreateMutex( ucQueueType );
+			if( xMutex != NULL )
+			{
+				vQueueSetMutexCeiling( xMutex, uxCeilingPriority );
+			}
+
+			return xMutex;
+		}
+
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+#endif /* configPSI_USE_CEILING_MUTEX */
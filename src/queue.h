@@ -1645,6 +1645,18 @@ void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber ) PRI
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+/*******************************************************************************************
+ * PSI SPECIFIC ADDITIONS
+ *******************************************************************************************/
+#if( configPSI_USE_CEILING_MUTEX == 1 )
+	/*
+	 * Set the priority ceiling of a mutex (0 = priority inheritance). Called by
+	 * xSemaphoreCreateMutexWithCeiling() and xSemaphoreSetCeiling(), should not
+	 * be called directly.
+	 */
+	void vQueueSetMutexCeiling( QueueHandle_t xMutex, UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+	QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType, UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
 
 #ifdef __cplusplus
 }
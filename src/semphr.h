@@ -1136,6 +1136,35 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define uxSemaphoreGetCount( xSemaphore ) uxQueueMessagesWaiting( ( QueueHandle_t ) ( xSemaphore ) )
 
+/*******************************************************************************************
+ * PSI SPECIFIC ADDITIONS
+ *******************************************************************************************/
+#if( configPSI_USE_CEILING_MUTEX == 1 )
+	/**
+	 * semphr.h
+	 * <pre>SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );</pre>
+	 *
+	 * Same as xSemaphoreCreateMutex() but the mutex uses the immediate priority
+	 * ceiling protocol instead of priority inheritance: the task taking the mutex
+	 * runs at uxCeilingPriority until it gives back its last mutex. The ceiling
+	 * must be at least the priority of all tasks using the mutex, then taking the
+	 * mutex never blocks (as long as the holder does not block).
+	 */
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		#define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority ) xQueueCreateMutexWithCeiling( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ) )
+	#endif
+
+	/**
+	 * semphr.h
+	 * <pre>void xSemaphoreSetCeiling( SemaphoreHandle_t xMutex, UBaseType_t uxCeilingPriority );</pre>
+	 *
+	 * Set the priority ceiling of a (recursive) mutex that is not held, e.g. one
+	 * created with xSemaphoreCreateMutexStatic(). A ceiling of 0 restores priority
+	 * inheritance.
+	 */
+	#define xSemaphoreSetCeiling( xMutex, uxCeilingPriority ) vQueueSetMutexCeiling( ( QueueHandle_t ) ( xMutex ), ( uxCeilingPriority ) )
+#endif
+
 #endif /* SEMAPHORE_H */
 
 
@@ -119,6 +119,14 @@
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
 /*-----------------------------------------------------------*/
 
+/* PSI specific: with the MPU stack guard, overflows are detected by the
+hardware, so no check is executed on context switches. */
+#if( configPSI_USE_MPU_STACK_GUARD == 1 )
+	#undef taskCHECK_FOR_STACK_OVERFLOW
+	#define taskCHECK_FOR_STACK_OVERFLOW()
+#endif
+/*-----------------------------------------------------------*/
+
 /* Remove stack overflow macro if not being used. */
 #ifndef taskCHECK_FOR_STACK_OVERFLOW
 	#define taskCHECK_FOR_STACK_OVERFLOW()
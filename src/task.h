@@ -154,6 +154,22 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * PSI specific: index of the notification value used by the task notification
+ * API functions without "Indexed" in their name.
+ *
+ * \ingroup TaskNotifications
+ */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( ( UBaseType_t ) 0U )
+
+/**
+ * PSI specific: returned by xTaskAbortDelayFromISR() if the task waits for an
+ * event, the wait can only be aborted from a task with xTaskAbortDelay().
+ *
+ * \ingroup TaskCtrl
+ */
+#define tskABORT_DELAY_EVENT_WAIT	( ( BaseType_t ) 2 )
+
 /**
  * task. h
  *
@@ -1687,6 +1703,7 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1694,6 +1711,12 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * PSI specific: each task has an array of configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES
+ * notification values, each with its own pending state.  The "Indexed" API
+ * functions take the array index as parameter, the other functions use
+ * tskDEFAULT_INDEX_TO_NOTIFY.  A task waiting on one index is not unblocked by
+ * notifications sent to another index.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1722,6 +1745,10 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify Index of the notification value of the task being
+ * notified (Indexed variants only), must be below
+ * configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1763,13 +1790,16 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1808,6 +1838,10 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify Index of the notification value of the task being
+ * notified (Indexed variants only), must be below
+ * configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1854,13 +1888,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1891,6 +1928,9 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn Index of the notification value to wait on (Indexed
+ * variant only), must be below configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry value
  * will be cleared in the calling task's notification value before the task
  * checks to see if any notifications are pending, and optionally blocks if no
@@ -1931,11 +1971,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -1971,17 +2014,23 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify Index of the notification value of the task being
+ * notified (Indexed variants only), must be below
+ * configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @return xTaskNotifyGive() is a macro that calls xTaskNotify() with the
  * eAction parameter set to eIncrement - so pdPASS is always returned.
  *
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ * <PRE>void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2020,6 +2069,10 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify Index of the notification value of the task being
+ * notified (Indexed variants only), must be below
+ * configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @param pxHigherPriorityTaskWoken  vTaskNotifyGiveFromISR() will set
  * *pxHigherPriorityTaskWoken to pdTRUE if sending the notification caused the
  * task to which the notification was sent to leave the Blocked state, and the
@@ -2032,11 +2085,14 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2080,6 +2136,9 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn Index of the notification value to wait on (Indexed
+ * variant only), must be below configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @param xClearCountOnExit if xClearCountOnExit is pdFALSE then the task's
  * notification value is decremented when the function exits.  In this way the
  * notification value acts like a counting semaphore.  If xClearCountOnExit is
@@ -2101,23 +2160,29 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
  * The task's notification value is not altered.  Set xTask to NULL to clear the
- * notification state of the calling task.
+ * notification state of the calling task.  The Indexed variant clears the state
+ * of the notification value uxIndexToClear.
  *
  * @return pdTRUE if the task's notification state was set to
  * eNotWaitingNotification, otherwise pdFALSE.
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear );
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2338,6 +2403,157 @@ void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNC
 
 TaskHandle_t xGetCurrentTaskHandle();
 
+/*
+ * Number of ticks that occurred while the scheduler was suspended and are not
+ * yet processed.
+ */
+UBaseType_t uxTaskGetPendedTicks( void );
+
+#if( configPSI_USE_BENCHMARK == 1 )
+	/*
+	 * Number of switches from one task to another since the scheduler started.
+	 */
+	uint32_t ulTaskGetSwitchCount( void );
+#endif
+
+#if( configPSI_USE_CEILING_MUTEX == 1 )
+	/*
+	 * Raise the priority of the calling task to the ceiling of a mutex it took.
+	 * Called from queue.c in a critical section, should not be called directly.
+	 */
+	void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configPSI_USE_EDF == 1 )
+	/*
+	 * Make the calling task periodic. The first period starts now. Tasks of
+	 * priority configPSI_EDF_PRIORITY are scheduled by their absolute deadline
+	 * (release + xRelativeDeadline), the task with the earliest deadline runs.
+	 * Tasks of this priority without a period run after all periodic tasks.
+	 */
+	void vTaskEdfSetPeriod( const TickType_t xPeriod, const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Signal that the work of the current period is done and block until the next
+	 * release. Returns pdFALSE if the period completed after its deadline (the
+	 * miss is reported to vApplicationEdfDeadlineMissHook() before blocking).
+	 */
+	BaseType_t xTaskEdfWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Period of a task (0 if the task is not periodic), current absolute deadline
+	 * and the number of deadline misses since vTaskEdfSetPeriod() was called.
+	 */
+	TickType_t xTaskEdfGetPeriod( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+	TickType_t xTaskEdfGetDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskEdfGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called in the context of a periodic task that completed a period after its
+	 * deadline (implemented by PsiFreeRTOS).
+	 */
+	void vApplicationEdfDeadlineMissHook( TaskHandle_t xTask, TickType_t xLateness );
+#endif
+
+#if( configPSI_USE_RESERVATION == 1 )
+	/* Action taken when a task exhausted the budget of its reservation. */
+	typedef enum
+	{
+		eReservationSuspend = 0,	/* The task does not run until the budget is replenished. */
+		eReservationDemote			/* The task runs at configPSI_RESERVATION_DEMOTE_PRIORITY until the budget is replenished. */
+	} eReservationAction;
+
+	/*
+	 * Attach a CPU reservation to a task: it may execute for ulBudget run time
+	 * counter counts per xPeriod ticks. The budget is enforced from the tick and
+	 * fully replenished at the start of each period (deferrable server). Tasks
+	 * holding a mutex are not restricted. xPeriod = 0 removes the reservation.
+	 * Returns pdFAIL if configPSI_RESERVATION_MAX_TASKS reservations exist.
+	 */
+	BaseType_t xTaskSetReservation( TaskHandle_t xTask, const TickType_t xPeriod, const uint32_t ulBudget, const eReservationAction eAction ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Period (0 if the task has no reservation), budget, execution time consumed
+	 * in the current period and number of periods the budget was exhausted in.
+	 */
+	TickType_t xTaskGetReservationPeriod( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+	uint32_t ulTaskGetReservationBudget( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+	uint32_t ulTaskGetReservationConsumed( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskGetReservationDepletions( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configPSI_USE_TASK_POOL == 1 )
+	/*
+	 * Create a task in one of the configPSI_TASK_POOL_SIZE pre-allocated slots
+	 * (TCB and stack of configPSI_TASK_POOL_STACK_DEPTH words). The heap is not
+	 * accessed. When the task is deleted, the slot is available again
+	 * immediately (or after the next context switch if the task deletes itself),
+	 * the idle task is not involved. Returns errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY
+	 * if all slots are in use.
+	 */
+	BaseType_t xTaskCreateFromPool(	TaskFunction_t pxTaskCode,
+									const char * const pcName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Number of free pool slots, lowest number of free slots since startup and
+	 * number of xTaskCreateFromPool() calls that failed because all slots were
+	 * in use.
+	 */
+	UBaseType_t uxTaskPoolGetFreeSlots( void ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskPoolGetMinimumEverFreeSlots( void ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskPoolGetFailures( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+	/*
+	 * Set the number of ticks a task runs before the next ready task of the same
+	 * priority is scheduled (requires configUSE_TIME_SLICING). A task that blocks
+	 * starts a new slice when it runs again. The default is
+	 * configPSI_TIME_SLICE_DEFAULT_QUANTUM.
+	 */
+	void vTaskSetTimeSliceQuantum( TaskHandle_t xTask, const UBaseType_t uxQuantum ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskGetTimeSliceQuantum( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+	/*
+	 * Set the preemption threshold of a task. While the task runs, it is only
+	 * preempted by tasks of higher priority than the threshold, round robin with
+	 * tasks of the same priority is suspended. A threshold not above the priority
+	 * of the task (e.g. the default 0) has no effect. Blocking, suspending or
+	 * deleting the task schedules the highest priority ready task as usual.
+	 * Passing NULL as xTask sets the threshold of the calling task.
+	 */
+	void vTaskSetPreemptionThreshold( TaskHandle_t xTask, UBaseType_t uxThreshold ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the effective preemption threshold of a task, which is never below
+	 * its (possibly inherited) priority.
+	 */
+	UBaseType_t uxTaskGetPreemptionThreshold( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+	/*
+	 * Interrupt safe version of xTaskAbortDelay(). Only tasks that block with a
+	 * finite timeout can be aborted. Returns pdFAIL if the task is not (yet) in
+	 * the Blocked state. Event lists are modified with interrupts enabled under
+	 * the queue lock, so a task waiting for an event is not aborted and
+	 * tskABORT_DELAY_EVENT_WAIT is returned (abort it from a task instead, e.g.
+	 * with xTimerPendFunctionCallFromISR()).
+	 */
+	BaseType_t xTaskAbortDelayFromISR( TaskHandle_t xTask, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Clear a pending abort of the calling task that was not consumed because the
+	 * blocking call returned for another reason.
+	 */
+	void vTaskResetDelayAborted( void ) PRIVILEGED_FUNCTION;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
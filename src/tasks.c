@@ -70,12 +70,35 @@ functions but without including stdio.h here. */
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED		( ( uint8_t ) 2 )
 
+/* PSI specific: each task has configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES
+notification values, each with its own state. */
+#if( configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 /*
  * The value used to fill the stack of a task when the task is created.  This
  * is used purely for checking the high water mark for tasks.
  */
 #define tskSTACK_FILL_BYTE	( 0xa5U )
 
+/* PSI specific: with the MPU stack guard the lowest bytes of the running task's
+stack cannot be accessed, so the free stack space is counted from the end of the
+guard (which also reflects the stack space that is really usable). */
+#if( configPSI_USE_MPU_STACK_GUARD == 1 )
+	#define prvSTACK_SCAN_START( pxTCB ) ( ( uint8_t * ) portSTACK_GUARD_END( ( pxTCB )->pxStack ) )
+#else
+	#define prvSTACK_SCAN_START( pxTCB ) ( ( uint8_t * ) ( pxTCB )->pxStack )
+#endif
+
+/* PSI specific: the stacks allocated by the kernel are enlarged by the guard and
+its alignment, so the requested depth remains usable. */
+#if( configPSI_USE_MPU_STACK_GUARD == 1 )
+	#define taskSTACK_GUARD_WORDS	portSTACK_GUARD_WORDS
+#else
+	#define taskSTACK_GUARD_WORDS	0UL
+#endif
+
 /* Sometimes the FreeRTOSConfig.h settings only allow a task to be created using
 dynamically allocated RAM, in which case when any task is deleted it is known
 that both the task's stack and TCB need to be freed.  Sometimes the
@@ -129,6 +152,66 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
+/* PSI specific: a running task with a preemption threshold above its priority is
+only preempted by tasks of higher priority than the threshold.  This also applies
+to tasks of the same priority (no time slicing). */
+#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+	#define taskTHRESHOLD_ACTIVE( pxTCB ) ( ( pxTCB )->uxPreemptionThreshold > ( pxTCB )->uxPriority )
+	#define taskPREEMPTION_LIMIT( pxTCB ) ( taskTHRESHOLD_ACTIVE( pxTCB ) ? ( pxTCB )->uxPreemptionThreshold : ( pxTCB )->uxPriority )
+
+	/* A readied task of equal priority only requests a switch if the running
+	task has no active threshold. */
+	#define taskREADIED_TASK_SWITCH_REQUIRED( pxTCB )												\
+		( taskTHRESHOLD_ACTIVE( pxCurrentTCB ) ?														\
+		  ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPreemptionThreshold ) :							\
+		  ( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority ) )
+#else
+	#define taskPREEMPTION_LIMIT( pxTCB ) ( ( pxTCB )->uxPriority )
+	#define taskREADIED_TASK_SWITCH_REQUIRED( pxTCB ) ( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority )
+#endif
+
+/* PSI specific: the tasks of the EDF priority level are kept sorted by their
+deadline, the task with the earliest deadline is always at the head of the
+list.  All other priority levels are scheduled round robin. */
+#if( configPSI_USE_EDF == 1 )
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#error configUSE_16_BIT_TICKS must be 0 when configPSI_USE_EDF is 1
+	#endif
+
+	#if( ( configPSI_EDF_PRIORITY < 1 ) || ( configPSI_EDF_PRIORITY >= configMAX_PRIORITIES ) )
+		#error configPSI_EDF_PRIORITY must be between 1 and configMAX_PRIORITIES - 1
+	#endif
+
+	#define taskGET_OWNER_OF_READY_LIST( uxPriority )													\
+	{																									\
+		if( ( uxPriority ) == ( UBaseType_t ) configPSI_EDF_PRIORITY )									\
+		{																								\
+			pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) ); \
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );		\
+		}																								\
+	}
+
+	/* Tasks without a period have no deadline and are ordered after all tasks
+	with a period, so they cannot starve the periodic tasks however long they
+	stay ready.  Deadlines are compared by their difference, so the order stays
+	correct when the tick count overflows. */
+	#define taskEDF_DEADLINE_BEFORE( pxTCB1, pxTCB2 )																	( ( ( pxTCB1 )->xEdfPeriod != ( TickType_t ) 0 ) &&																  ( ( ( pxTCB2 )->xEdfPeriod == ( TickType_t ) 0 ) ||																( ( BaseType_t ) ( ( pxTCB1 )->xEdfDeadline - ( pxTCB2 )->xEdfDeadline ) < ( BaseType_t ) 0 ) ) )
+
+	/* A task preempts the running task if it has a higher priority or an
+	earlier deadline within the EDF priority level. */
+	#define taskPREEMPTS_CURRENT_TASK( pxTCB )																\
+		( ( ( pxTCB )->uxPriority > taskPREEMPTION_LIMIT( pxCurrentTCB ) ) ||								\
+		  ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configPSI_EDF_PRIORITY ) &&							\
+			( taskPREEMPTION_LIMIT( pxCurrentTCB ) == ( UBaseType_t ) configPSI_EDF_PRIORITY ) &&			\
+			taskEDF_DEADLINE_BEFORE( ( pxTCB ), pxCurrentTCB ) ) )
+#else
+	#define taskGET_OWNER_OF_READY_LIST( uxPriority ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+	#define taskPREEMPTS_CURRENT_TASK( pxTCB ) ( ( pxTCB )->uxPriority > taskPREEMPTION_LIMIT( pxCurrentTCB ) )
+#endif
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -160,7 +243,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskGET_OWNER_OF_READY_LIST( uxTopPriority );													\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -190,7 +273,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskGET_OWNER_OF_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -202,7 +285,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	{																									\
 		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
 		{																								\
-			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+			portRESET_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority );								\
 		}																								\
 	}
 
@@ -226,17 +309,71 @@ count overflows. */
 	prvResetNextTaskUnblockTime();																	\
 }
 
+/* PSI specific: with the delay wheel, tasks blocked with a timeout are stored
+in the slot of their wake time (modulo the number of slots) in insertion order.
+Insertion is constant time, each tick only checks the tasks in its slot.  The
+wake times are compared for equality, so no overflow list is required. */
+#if( configPSI_USE_DELAY_WHEEL == 1 )
+	#if( ( configPSI_DELAY_WHEEL_SLOTS & ( configPSI_DELAY_WHEEL_SLOTS - 1 ) ) != 0 )
+		#error configPSI_DELAY_WHEEL_SLOTS must be a power of two
+	#endif
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be 0 when configPSI_USE_DELAY_WHEEL is 1
+	#endif
+
+	#define taskDELAY_WHEEL_MASK ( ( TickType_t ) configPSI_DELAY_WHEEL_SLOTS - ( TickType_t ) 1 )
+
+	#define taskIS_DELAYED_LIST( pxList ) ( ( ( pxList ) >= &( xDelayWheel[ 0 ] ) ) && ( ( pxList ) < &( xDelayWheel[ configPSI_DELAY_WHEEL_SLOTS ] ) ) )
+#else
+	#define taskIS_DELAYED_LIST( pxList ) ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+#endif
+
+/* PSI specific: CPU reservations measure the execution time with the run time
+counter and compare tick counts with a signed difference. */
+#if( configPSI_USE_RESERVATION == 1 )
+	#if( configGENERATE_RUN_TIME_STATS != 1 ) || ( configUSE_MUTEXES != 1 )
+		#error configGENERATE_RUN_TIME_STATS and configUSE_MUTEXES must be 1 when configPSI_USE_RESERVATION is 1
+	#endif
+
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#error configPSI_USE_RESERVATION is not supported with 16-bit ticks
+	#endif
+#endif
+
+/* PSI specific: tasks created from the task pool use a pre-allocated TCB and
+stack slot, they are recognised by the address of their TCB. */
+#if( configPSI_USE_TASK_POOL == 1 )
+	#define taskIS_POOL_TCB( pxTCB ) ( ( ( pxTCB ) >= &( xTaskPoolTCBs[ 0 ] ) ) && ( ( pxTCB ) < &( xTaskPoolTCBs[ configPSI_TASK_POOL_SIZE ] ) ) )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )																\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#if( configPSI_USE_EDF == 1 )
+	/* PSI specific: tasks of the EDF priority are inserted by deadline. */
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configPSI_EDF_PRIORITY )							\
+		{																								\
+			prvEdfInsertIntoReadyList( pxTCB );															\
+		}																								\
+		else																							\
+		{																								\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																								\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#else
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -322,8 +459,8 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments above the definition of
@@ -336,6 +473,37 @@ typedef struct tskTaskControlBlock
 		uint8_t ucDelayAborted;
 	#endif
 
+	/* PSI specific: periodic tasks of the EDF priority level. */
+	#if( configPSI_USE_EDF == 1 )
+		TickType_t xEdfPeriod;			/*< Period of the task, 0 if the task is not periodic. */
+		TickType_t xEdfRelativeDeadline;	/*< Deadline relative to the release of the task. */
+		TickType_t xEdfRelease;			/*< Tick count of the current release. */
+		TickType_t xEdfDeadline;		/*< Absolute deadline, used to sort the EDF ready list. */
+		UBaseType_t uxEdfDeadlineMisses;	/*< Number of periods that completed after their deadline. */
+	#endif
+
+	/* PSI specific: CPU reservation (budget per period). */
+	#if( configPSI_USE_RESERVATION == 1 )
+		TickType_t xResPeriod;			/*< Replenishment period, 0 if the task has no reservation. */
+		TickType_t xResReplenishTime;	/*< Tick count of the next replenishment. */
+		uint32_t ulResBudget;			/*< Execution time per period in run time counter counts. */
+		uint32_t ulResConsumed;			/*< Execution time consumed in the current period (up to the last switch in). */
+		UBaseType_t uxResDepletions;	/*< Number of periods in which the budget was exhausted. */
+		uint8_t ucResAction;			/*< eReservationAction applied on exhaustion. */
+		uint8_t ucResDepleted;			/*< pdTRUE while the budget of the current period is exhausted. */
+	#endif
+
+	/* PSI specific: round robin quantum. */
+	#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+		UBaseType_t uxTimeSliceQuantum;	/*< Ticks the task runs before an equal priority task is scheduled. */
+		UBaseType_t uxTimeSliceTicks;	/*< Ticks used of the current slice. */
+	#endif
+
+	/* PSI specific: preemption threshold. */
+	#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t uxPreemptionThreshold;	/*< The running task is only preempted by tasks of higher priority, no effect if not above uxPriority. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -345,14 +513,33 @@ typedef tskTCB TCB_t;
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+PRIVILEGED_DATA portTCM_DATA TCB_t * volatile pxCurrentTCB = NULL;
 
 /* Lists for ready and blocked tasks. --------------------*/
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
+PRIVILEGED_DATA portTCM_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if( configPSI_USE_DELAY_WHEEL == 1 )
+	PRIVILEGED_DATA portTCM_DATA static List_t xDelayWheel[ configPSI_DELAY_WHEEL_SLOTS ];	/*< PSI specific: delayed tasks by wake time slot (replaces the delayed lists). */
+#endif
+#if( configPSI_USE_RESERVATION == 1 )
+	PRIVILEGED_DATA static List_t xReservationDepletedList;									/*< PSI specific: tasks suspended until their budget is replenished. */
+	PRIVILEGED_DATA static TCB_t * pxReservationTasks[ configPSI_RESERVATION_MAX_TASKS ];	/*< PSI specific: tasks with a reservation (NULL = free entry). */
+#endif
+#if( configPSI_USE_TASK_POOL == 1 )
+	/* PSI specific: task pool.  Slots are handed out in index order first, released
+	slots are kept on a stack of free indices, so no initialisation is required. */
+	PRIVILEGED_DATA static TCB_t xTaskPoolTCBs[ configPSI_TASK_POOL_SIZE ];
+	PRIVILEGED_DATA static StackType_t xTaskPoolStacks[ configPSI_TASK_POOL_SIZE ][ configPSI_TASK_POOL_STACK_DEPTH + taskSTACK_GUARD_WORDS ];
+	PRIVILEGED_DATA static UBaseType_t uxTaskPoolReleasedSlots[ configPSI_TASK_POOL_SIZE ];
+	PRIVILEGED_DATA static UBaseType_t uxTaskPoolReleased = ( UBaseType_t ) 0U;		/*< Number of entries in uxTaskPoolReleasedSlots. */
+	PRIVILEGED_DATA static UBaseType_t uxTaskPoolNeverUsed = ( UBaseType_t ) 0U;		/*< Index of the first slot that was never used. */
+	PRIVILEGED_DATA static UBaseType_t uxTaskPoolMinimumEverFree = ( UBaseType_t ) configPSI_TASK_POOL_SIZE;
+	PRIVILEGED_DATA static UBaseType_t uxTaskPoolFailures = ( UBaseType_t ) 0U;
+	PRIVILEGED_DATA static TCB_t * volatile pxTaskPoolPendingRelease = NULL;			/*< Task that deleted itself, released at the next context switch. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -370,15 +557,22 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+PRIVILEGED_DATA portTCM_DATA static volatile TickType_t xTickCount 	= ( TickType_t ) configINITIAL_TICK_COUNT;
+PRIVILEGED_DATA portTCM_DATA static volatile UBaseType_t uxTopReadyPriority 	= tskIDLE_PRIORITY;
+#ifdef portREADY_PRIORITY_GROUPS
+	/* PSI specific: second level of the ready priority bit map (see portmacro.h). */
+	PRIVILEGED_DATA portTCM_DATA static volatile UBaseType_t uxTopReadyPriorityGroups[ portREADY_PRIORITY_GROUPS ] = { 0 };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+PRIVILEGED_DATA portTCM_DATA static volatile BaseType_t xYieldPending 	= pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+PRIVILEGED_DATA portTCM_DATA static volatile TickType_t xNextTaskUnblockTime	= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if( configPSI_USE_BENCHMARK == 1 )
+	PRIVILEGED_DATA static volatile uint32_t ulTaskSwitchCount		= 0UL;	/*< PSI specific: number of context switches (for benchmarks). */
+#endif
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -388,7 +582,7 @@ moves the task's event list item into the xPendingReadyList, ready for the
 kernel to move the task from the pending ready list into the real ready list
 when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
-PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
+PRIVILEGED_DATA portTCM_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
@@ -478,6 +672,14 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * PSI specific: insert a task into the ready list of the EDF priority, sorted
+ * by deadline.
+ */
+#if( configPSI_USE_EDF == 1 )
+	static void prvEdfInsertIntoReadyList( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -534,6 +736,56 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+/*
+ * PSI specific: insert the state list item of a task into the delay wheel slot
+ * of its wake time (item value).
+ */
+#if( configPSI_USE_DELAY_WHEEL == 1 )
+	static void prvDelayWheelInsert( ListItem_t * const pxStateListItem ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * PSI specific: process the ticks pended while the scheduler was suspended in
+ * one pass (instead of calling xTaskIncrementTick() once per tick).  Returns
+ * pdTRUE if a context switch is required.
+ */
+#if( configPSI_USE_TICK_CATCH_UP == 1 )
+	static BaseType_t prvCatchUpPendedTicks( TickType_t xTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * PSI specific: replenish the budgets of all tasks with a reservation whose
+ * period elapsed and enforce the budget of the running task.  Called from the
+ * tick, returns pdTRUE if a context switch is required.
+ */
+#if( configPSI_USE_RESERVATION == 1 )
+	static BaseType_t prvReservationTick( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * PSI specific: return the TCB and stack slot of a deleted task to the task
+ * pool.
+ */
+#if( configPSI_USE_TASK_POOL == 1 )
+	static void prvTaskPoolRelease( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * PSI specific: account xTicks to the time slice of the running task, returns
+ * pdTRUE (and restarts the slice) if its quantum elapsed.
+ */
+#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+	static BaseType_t prvTimeSliceElapsed( const TickType_t xTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * PSI specific: returns pdTRUE if the running task is still ready and no ready
+ * task exceeds its preemption threshold, hence it must keep running.
+ */
+#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+	static BaseType_t prvPreemptionThresholdHolds( void ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -738,6 +990,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 	{
 	TCB_t *pxNewTCB;
 	BaseType_t xReturn;
+	const uint32_t ulStackDepth = ( uint32_t ) usStackDepth + ( uint32_t ) taskSTACK_GUARD_WORDS;
 
 		/* If the stack grows down then allocate the stack then the TCB so the stack
 		does not grow into the TCB.  Likewise if the stack grows up then allocate
@@ -754,7 +1007,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				/* Allocate space for the stack used by the task being created.
 				The base of the stack memory stored in the TCB so the task can
 				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) ulStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 				if( pxNewTCB->pxStack == NULL )
 				{
@@ -769,7 +1022,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		StackType_t *pxStack;
 
 			/* Allocate space for the stack used by the task being created. */
-			pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) ulStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			if( pxStack != NULL )
 			{
@@ -805,7 +1058,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			}
 			#endif /* configSUPPORT_STATIC_ALLOCATION */
 
-			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+			prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
 			prvAddNewTaskToReadyList( pxNewTCB );
 			xReturn = pdPASS;
 		}
@@ -846,6 +1099,14 @@ UBaseType_t x;
 		uxPriority &= ~portPRIVILEGE_BIT;
 	#endif /* portUSING_MPU_WRAPPERS == 1 */
 
+	/* PSI specific: at least a minimal stack must remain usable above the guard
+	(statically allocated stacks are not enlarged). */
+	#if( configPSI_USE_MPU_STACK_GUARD == 1 )
+	{
+		configASSERT( ( portSTACK_GUARD_END( pxNewTCB->pxStack ) + ( ( uint32_t ) configMINIMAL_STACK_SIZE * sizeof( StackType_t ) ) ) <= ( uint32_t ) ( pxNewTCB->pxStack + ulStackDepth ) );
+	}
+	#endif
+
 	/* Avoid dependency on memset() if it is not required. */
 	#if( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
 	{
@@ -928,6 +1189,41 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if( configPSI_USE_EDF == 1 )
+	{
+		pxNewTCB->xEdfPeriod = ( TickType_t ) 0;
+		pxNewTCB->xEdfRelativeDeadline = ( TickType_t ) 0;
+		pxNewTCB->xEdfRelease = ( TickType_t ) 0;
+		pxNewTCB->xEdfDeadline = ( TickType_t ) 0;
+		pxNewTCB->uxEdfDeadlineMisses = ( UBaseType_t ) 0;
+	}
+	#endif
+
+	#if( configPSI_USE_RESERVATION == 1 )
+	{
+		pxNewTCB->xResPeriod = ( TickType_t ) 0;
+		pxNewTCB->xResReplenishTime = ( TickType_t ) 0;
+		pxNewTCB->ulResBudget = 0UL;
+		pxNewTCB->ulResConsumed = 0UL;
+		pxNewTCB->uxResDepletions = ( UBaseType_t ) 0;
+		pxNewTCB->ucResAction = ( uint8_t ) eReservationSuspend;
+		pxNewTCB->ucResDepleted = pdFALSE;
+	}
+	#endif
+
+	#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+	{
+		pxNewTCB->uxTimeSliceQuantum = ( UBaseType_t ) configPSI_TIME_SLICE_DEFAULT_QUANTUM;
+		pxNewTCB->uxTimeSliceTicks = ( UBaseType_t ) 0;
+	}
+	#endif
+
+	#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+	{
+		pxNewTCB->uxPreemptionThreshold = ( UBaseType_t ) 0;
+	}
+	#endif
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -979,8 +1275,11 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -1139,6 +1438,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			/* PSI specific: the reservation ends with the task. */
+			#if( configPSI_USE_RESERVATION == 1 )
+			{
+			UBaseType_t uxIndex;
+
+				for( uxIndex = ( UBaseType_t ) 0; uxIndex < ( UBaseType_t ) configPSI_RESERVATION_MAX_TASKS; uxIndex++ )
+				{
+					if( pxReservationTasks[ uxIndex ] == pxTCB )
+					{
+						pxReservationTasks[ uxIndex ] = NULL;
+					}
+				}
+			}
+			#endif
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1147,17 +1461,38 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			if( pxTCB == pxCurrentTCB )
 			{
-				/* A task is deleting itself.  This cannot complete within the
-				task itself, as a context switch to another task is required.
-				Place the task in the termination list.  The idle task will
-				check the termination list and free up any memory allocated by
-				the scheduler for the TCB and stack of the deleted task. */
-				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+				#if( configPSI_USE_TASK_POOL == 1 )
+				if( taskIS_POOL_TCB( pxTCB ) )
+				{
+					/* PSI specific: the stack is in use until the context
+					switch, so the slot is released there (not by the idle
+					task). */
+					portCLEAN_UP_TCB( pxTCB );
 
-				/* Increment the ucTasksDeleted variable so the idle task knows
-				there is a task that has been deleted and that it should therefore
-				check the xTasksWaitingTermination list. */
-				++uxDeletedTasksWaitingCleanUp;
+					#if ( configUSE_NEWLIB_REENTRANT == 1 )
+					{
+						_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+					}
+					#endif
+
+					--uxCurrentNumberOfTasks;
+					pxTaskPoolPendingRelease = pxTCB;
+				}
+				else
+				#endif /* configPSI_USE_TASK_POOL */
+				{
+					/* A task is deleting itself.  This cannot complete within the
+					task itself, as a context switch to another task is required.
+					Place the task in the termination list.  The idle task will
+					check the termination list and free up any memory allocated by
+					the scheduler for the TCB and stack of the deleted task. */
+					vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+
+					/* Increment the ucTasksDeleted variable so the idle task knows
+					there is a task that has been deleted and that it should therefore
+					check the xTasksWaitingTermination list. */
+					++uxDeletedTasksWaitingCleanUp;
+				}
 
 				/* The pre-delete hook is primarily for the Windows simulator,
 				in which Windows specific clean up operations are performed,
@@ -1351,7 +1686,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			if( taskIS_DELAYED_LIST( pxStateList ) )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1375,6 +1710,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 			#endif
 
+			#if( configPSI_USE_RESERVATION == 1 )
+				else if( pxStateList == &xReservationDepletedList )
+				{
+					/* PSI specific: suspended until the budget is replenished. */
+					eReturn = eSuspended;
+				}
+			#endif
+
 			#if ( INCLUDE_vTaskDelete == 1 )
 				else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
 				{
@@ -1664,11 +2007,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but is
+						now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -1797,7 +2145,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskREADIED_TASK_SWITCH_REQUIRED( pxTCB ) )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1865,7 +2213,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskREADIED_TASK_SWITCH_REQUIRED( pxTCB ) )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1972,6 +2320,13 @@ BaseType_t xReturn;
 		starts to run. */
 		portDISABLE_INTERRUPTS();
 
+		/* PSI specific: guard the stack of the task that will run first. */
+		#if ( configPSI_USE_MPU_STACK_GUARD == 1 )
+		{
+			vPortSetStackGuard( pxCurrentTCB->pxStack );
+		}
+		#endif
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2070,6 +2425,15 @@ void vTaskSuspendAll( void )
 			{
 				uxHigherPriorityReadyTasks = pdTRUE;
 			}
+
+			/* PSI specific: with the two level bit map the idle priority
+			shares the least significant bit with 31 other priorities. */
+			#ifdef portREADY_PRIORITY_GROUPS
+				if( uxTopReadyPriorityGroups[ 0 ] > uxLeastSignificantBit )
+				{
+					uxHigherPriorityReadyTasks = pdTRUE;
+				}
+			#endif
 		}
 		#endif
 
@@ -2135,7 +2499,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskREADIED_TASK_SWITCH_REQUIRED( pxTCB ) )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2163,6 +2527,22 @@ BaseType_t xAlreadyYielded = pdFALSE;
 				{
 					UBaseType_t uxPendedCounts = uxPendedTicks; /* Non-volatile copy. */
 
+					#if( configPSI_USE_TICK_CATCH_UP == 1 )
+					if( uxPendedCounts > ( UBaseType_t ) 0U )
+					{
+						/* PSI specific: batched catch-up. */
+						if( prvCatchUpPendedTicks( ( TickType_t ) uxPendedCounts ) != pdFALSE )
+						{
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						uxPendedTicks = 0;
+					}
+					#else
 					if( uxPendedCounts > ( UBaseType_t ) 0U )
 					{
 						do
@@ -2180,6 +2560,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 						uxPendedTicks = 0;
 					}
+					#endif /* configPSI_USE_TICK_CATCH_UP */
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
@@ -2366,15 +2747,26 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if( configPSI_USE_DELAY_WHEEL == 1 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				for( uxQueue = 0; ( uxQueue < ( UBaseType_t ) configPSI_DELAY_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayWheel[ uxQueue ] ), pcNameToQuery );
+				}
 			}
-
-			if( pxTCB == NULL )
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
+
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2386,6 +2778,15 @@ TCB_t *pxTCB;
 			}
 			#endif
 
+			#if( configPSI_USE_RESERVATION == 1 )
+			{
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &xReservationDepletedList, pcNameToQuery );
+				}
+			}
+			#endif
+
 			#if( INCLUDE_vTaskDelete == 1 )
 			{
 				if( pxTCB == NULL )
@@ -2426,8 +2827,19 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if( configPSI_USE_DELAY_WHEEL == 1 )
+				{
+					for( uxQueue = 0; uxQueue < ( UBaseType_t ) configPSI_DELAY_WHEEL_SLOTS; uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayWheel[ uxQueue ] ), eBlocked );
+					}
+				}
+				#else
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2445,6 +2857,12 @@ TCB_t *pxTCB;
 				}
 				#endif
 
+				#if( configPSI_USE_RESERVATION == 1 )
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xReservationDepletedList, eSuspended );
+				}
+				#endif
+
 				#if ( configGENERATE_RUN_TIME_STATS == 1)
 				{
 					if( pulTotalRunTime != NULL )
@@ -2560,7 +2978,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2586,7 +3004,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 #endif /* INCLUDE_xTaskAbortDelay */
 /*----------------------------------------------------------*/
 
-BaseType_t xTaskIncrementTick( void )
+portTCM_CODE BaseType_t xTaskIncrementTick( void )
 {
 TCB_t * pxTCB;
 TickType_t xItemValue;
@@ -2606,6 +3024,66 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
+		#if( configPSI_USE_DELAY_WHEEL == 1 )
+		{
+		List_t * const pxSlot = &( xDelayWheel[ xConstTickCount & taskDELAY_WHEEL_MASK ] );
+		ListItem_t *pxIterator, *pxNextItem;
+
+			/* PSI specific: there are no delayed lists to switch, but the
+			overflows are still counted for xTaskCheckForTimeOut(). */
+			if( xConstTickCount == ( TickType_t ) 0U )
+			{
+				xNumOfOverflows++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* PSI specific: check the tasks in the wheel slot of this tick,
+			tasks waking in a later round of the wheel are skipped. */
+			for( pxIterator = listGET_HEAD_ENTRY( pxSlot ); pxIterator != listGET_END_MARKER( pxSlot ); pxIterator = pxNextItem )
+			{
+				pxNextItem = listGET_NEXT( pxIterator );
+
+				if( listGET_LIST_ITEM_VALUE( pxIterator ) == xConstTickCount )
+				{
+					pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					prvAddTaskToReadyList( pxTCB );
+
+					#if (  configUSE_PREEMPTION == 1 )
+					{
+						if( taskREADIED_TASK_SWITCH_REQUIRED( pxTCB ) )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_PREEMPTION */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			( void ) xItemValue;
+		}
+		#else
 		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
 		{
 			taskSWITCH_DELAYED_LISTS();
@@ -2683,7 +3161,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 						only be performed if the unblocked task has a
 						priority that is equal to or higher than the
 						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						if( taskREADIED_TASK_SWITCH_REQUIRED( pxTCB ) )
 						{
 							xSwitchRequired = pdTRUE;
 						}
@@ -2696,15 +3174,52 @@ BaseType_t xSwitchRequired = pdFALSE;
 				}
 			}
 		}
+		#endif /* configPSI_USE_DELAY_WHEEL */
+
+		#if( configPSI_USE_RESERVATION == 1 )
+		{
+			if( prvReservationTick() != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+		}
+		#endif
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			/* PSI specific: a running task with an active preemption threshold
+			is not time sliced. */
+			#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+				if( taskTHRESHOLD_ACTIVE( pxCurrentTCB ) )
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				else
+			#endif
+			/* PSI specific: the EDF priority level is not time sliced. */
+			#if( configPSI_USE_EDF == 1 )
+				if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+					( pxCurrentTCB->uxPriority != ( UBaseType_t ) configPSI_EDF_PRIORITY ) )
+			#else
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#endif
 			{
-				xSwitchRequired = pdTRUE;
+				#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+				{
+					/* PSI specific: rotate after the quantum of the task. */
+					if( prvTimeSliceElapsed( ( TickType_t ) 1 ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+				}
+				#else
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				#endif
 			}
 			else
 			{
@@ -2734,7 +3249,8 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 		/* The tick hook gets called at regular intervals, even if the
 		scheduler is locked. */
-		#if ( configUSE_TICK_HOOK == 1 )
+		/* PSI specific: unless it is called once after the batched catch-up. */
+		#if ( ( configUSE_TICK_HOOK == 1 ) && ( ( configPSI_USE_TICK_CATCH_UP != 1 ) || ( configPSI_TICK_CATCH_UP_HOOK != 1 ) ) )
 		{
 			vApplicationTickHook();
 		}
@@ -2848,7 +3364,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
+portTCM_CODE void vTaskSwitchContext( void )
 {
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
@@ -2884,18 +3400,85 @@ void vTaskSwitchContext( void )
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
-				ulTaskSwitchedInTime = ulTotalRunTime;
-		}
+
+				#if( configPSI_USE_RESERVATION == 1 )
+				{
+					/* PSI specific: wrap safe, the budget must not be lost on
+					a timer overflow. */
+					pxCurrentTCB->ulResConsumed += ( ulTotalRunTime - ulTaskSwitchedInTime );
+				}
+				#endif
+				ulTaskSwitchedInTime = ulTotalRunTime;
+		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
 		/* Check for stack overflow, if configured. */
 		taskCHECK_FOR_STACK_OVERFLOW();
 
-		/* Select a new task to run using either the generic C or port
-		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK();
+		/* PSI specific: the running task is not replaced by tasks below its
+		preemption threshold. */
+		#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+			if( prvPreemptionThresholdHolds() != pdFALSE )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else
+		#endif
+		{
+			/* Select a new task to run using either the generic C or port
+			optimised asm code. */
+			#if( ( configPSI_USE_BENCHMARK == 1 ) || ( configPSI_USE_TIME_SLICE_QUANTUM == 1 ) )
+			{
+			TCB_t * const pxPreviousTCB = pxCurrentTCB;
+
+				taskSELECT_HIGHEST_PRIORITY_TASK();
+				if( pxCurrentTCB != pxPreviousTCB )
+				{
+					/* PSI specific: count the switches to another task. */
+					#if( configPSI_USE_BENCHMARK == 1 )
+					{
+						ulTaskSwitchCount++;
+					}
+					#endif
+
+					/* PSI specific: a task switched in starts a full slice,
+					also when it was preempted before its quantum elapsed. */
+					#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+					{
+						pxCurrentTCB->uxTimeSliceTicks = ( UBaseType_t ) 0;
+					}
+					#endif
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+				taskSELECT_HIGHEST_PRIORITY_TASK();
+			#endif
+		}
 		traceTASK_SWITCHED_IN();
 
+		/* PSI specific: move the MPU stack guard to the task switched in. */
+		#if ( configPSI_USE_MPU_STACK_GUARD == 1 )
+		{
+			vPortSetStackGuard( pxCurrentTCB->pxStack );
+		}
+		#endif
+
+		/* PSI specific: the context of a task that deleted itself was saved,
+		its stack is no longer used. */
+		#if( configPSI_USE_TASK_POOL == 1 )
+		{
+			if( pxTaskPoolPendingRelease != NULL )
+			{
+				prvTaskPoolRelease( pxTaskPoolPendingRelease );
+				pxTaskPoolPendingRelease = NULL;
+			}
+		}
+		#endif
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2907,7 +3490,7 @@ void vTaskSwitchContext( void )
 }
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
+portTCM_CODE void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
 {
 	configASSERT( pxEventList );
 
@@ -2981,7 +3564,7 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 #endif /* configUSE_TIMERS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+portTCM_CODE BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 {
 TCB_t *pxUnblockedTCB;
 BaseType_t xReturn;
@@ -3015,7 +3598,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3072,7 +3655,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3446,6 +4029,15 @@ UBaseType_t uxPriority;
 	vListInitialise( &xDelayedTaskList2 );
 	vListInitialise( &xPendingReadyList );
 
+	#if( configPSI_USE_DELAY_WHEEL == 1 )
+	{
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configPSI_DELAY_WHEEL_SLOTS; uxPriority++ )
+		{
+			vListInitialise( &( xDelayWheel[ uxPriority ] ) );
+		}
+	}
+	#endif
+
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
 		vListInitialise( &xTasksWaitingTermination );
@@ -3458,6 +4050,12 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
+	#if( configPSI_USE_RESERVATION == 1 )
+	{
+		vListInitialise( &xReservationDepletedList );
+	}
+	#endif
+
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
@@ -3577,7 +4175,7 @@ static void prvCheckTasksWaitingTermination( void )
 			}
 			#else
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( prvSTACK_SCAN_START( pxTCB ) );
 			}
 			#endif
 		}
@@ -3655,7 +4253,7 @@ static void prvCheckTasksWaitingTermination( void )
 
 		#if portSTACK_GROWTH < 0
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			pucEndOfStack = prvSTACK_SCAN_START( pxTCB );
 		}
 		#else
 		{
@@ -3688,40 +4286,50 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 
-		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+		/* PSI specific: pool slots are returned to the pool immediately. */
+		#if( configPSI_USE_TASK_POOL == 1 )
+		if( taskIS_POOL_TCB( pxTCB ) )
 		{
-			/* The task can only have been allocated dynamically - free both
-			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			prvTaskPoolRelease( pxTCB );
 		}
-		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
+		else
+		#endif /* configPSI_USE_TASK_POOL */
 		{
-			/* The task could have been allocated statically or dynamically, so
-			check what was statically allocated before trying to free the
-			memory. */
-			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
 			{
-				/* Both the stack and TCB were allocated dynamically, so both
-				must be freed. */
+				/* The task can only have been allocated dynamically - free both
+				the stack and TCB. */
 				vPortFree( pxTCB->pxStack );
 				vPortFree( pxTCB );
 			}
-			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
-			{
-				/* Only the stack was statically allocated, so the TCB is the
-				only memory that must be freed. */
-				vPortFree( pxTCB );
-			}
-			else
+			#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
 			{
-				/* Neither the stack nor the TCB were allocated dynamically, so
-				nothing needs to be freed. */
-				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
-				mtCOVERAGE_TEST_MARKER();
+				/* The task could have been allocated statically or dynamically, so
+				check what was statically allocated before trying to free the
+				memory. */
+				if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+				{
+					/* Both the stack and TCB were allocated dynamically, so both
+					must be freed. */
+					vPortFree( pxTCB->pxStack );
+					vPortFree( pxTCB );
+				}
+				else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+				{
+					/* Only the stack was statically allocated, so the TCB is the
+					only memory that must be freed. */
+					vPortFree( pxTCB );
+				}
+				else
+				{
+					/* Neither the stack nor the TCB were allocated dynamically, so
+					nothing needs to be freed. */
+					configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 		}
-		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 	}
 
 #endif /* INCLUDE_vTaskDelete */
@@ -4409,17 +5017,19 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWaitOn < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4447,17 +5057,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4465,7 +5075,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4477,22 +5087,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWaitOn < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4525,14 +5137,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4541,11 +5153,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4557,44 +5169,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4637,7 +5250,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4663,7 +5276,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4671,6 +5284,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4696,30 +5310,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4755,7 +5369,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4787,13 +5401,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4817,12 +5432,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -4845,7 +5460,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4876,20 +5491,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < ( UBaseType_t ) configPSI_TASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -4906,7 +5523,7 @@ TickType_t uxReturn;
 /*-----------------------------------------------------------*/
 
 
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
+portTCM_CODE static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
 const TickType_t xConstTickCount = xTickCount;
@@ -4952,6 +5569,12 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+			#if( configPSI_USE_DELAY_WHEEL == 1 )
+			{
+				/* PSI specific: no ordering or overflow handling required. */
+				prvDelayWheelInsert( &( pxCurrentTCB->xStateListItem ) );
+			}
+			#else
 			if( xTimeToWake < xConstTickCount )
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
@@ -4976,6 +5599,7 @@ const TickType_t xConstTickCount = xTickCount;
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+			#endif /* configPSI_USE_DELAY_WHEEL */
 		}
 	}
 	#else /* INCLUDE_vTaskSuspend */
@@ -4988,6 +5612,12 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+		#if( configPSI_USE_DELAY_WHEEL == 1 )
+		{
+			/* PSI specific: no ordering or overflow handling required. */
+			prvDelayWheelInsert( &( pxCurrentTCB->xStateListItem ) );
+		}
+		#else
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
@@ -5010,12 +5640,37 @@ const TickType_t xConstTickCount = xTickCount;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configPSI_USE_DELAY_WHEEL */
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
 		( void ) xCanBlockIndefinitely;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 }
+/*-----------------------------------------------------------*/
+
+#if( configPSI_USE_DELAY_WHEEL == 1 )
+
+	portTCM_CODE static void prvDelayWheelInsert( ListItem_t * const pxStateListItem )
+	{
+	TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxStateListItem );
+
+		/* The slot of the current tick was already processed, a task waking in
+		this tick is woken in the next one (as with the sorted lists). */
+		if( xTimeToWake == xTickCount )
+		{
+			xTimeToWake++;
+			listSET_LIST_ITEM_VALUE( pxStateListItem, xTimeToWake );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vListInsertEnd( &( xDelayWheel[ xTimeToWake & taskDELAY_WHEEL_MASK ] ), pxStateListItem );
+	}
+
+#endif /* configPSI_USE_DELAY_WHEEL */
 
 /* Code below here allows additional code to be inserted into this source file,
 especially where access to file scope functions and data is needed (for example
@@ -5054,4 +5709,938 @@ TaskHandle_t xGetCurrentTaskHandle() {
 	return (TaskHandle_t) pxCurrentTCB;
 }
 
+UBaseType_t uxTaskGetPendedTicks( void )
+{
+	return uxPendedTicks;
+}
+
+#if( configPSI_USE_BENCHMARK == 1 )
+	uint32_t ulTaskGetSwitchCount( void )
+	{
+		return ulTaskSwitchCount;
+	}
+#endif
+
+#if( configPSI_USE_CEILING_MUTEX == 1 )
+	void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		/* The ceiling must not be below the priority of any task using the
+		mutex. */
+		configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+		if( pxTCB->uxPriority < uxCeilingPriority )
+		{
+			/* Same as an inherited priority, the base priority is kept and
+			restored when the last mutex is given back. */
+			if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The running task is in the ready state, raising its own priority
+			never requires a context switch. */
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->uxPriority = uxCeilingPriority;
+			prvAddTaskToReadyList( pxTCB );
+
+			traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+#endif
+
+#if( configPSI_USE_EDF == 1 )
+	static void prvEdfInsertIntoReadyList( TCB_t *pxTCB )
+	{
+	List_t * const pxList = &( pxReadyTasksLists[ configPSI_EDF_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t *pxIterator;
+
+		/* Insert behind all tasks with an earlier or the same deadline, so tasks
+		with the same deadline are scheduled in FIFO order.  Tasks without a
+		period are always appended at the tail. */
+		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext != ( ListItem_t * ) &( pxList->xListEnd ); pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			if( taskEDF_DEADLINE_BEFORE( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator->pxNext ) ) )
+			{
+				break;
+			}
+		}
+
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pvContainer = ( void * ) pxList;
+		( pxList->uxNumberOfItems )++;
+	}
+
+	void vTaskEdfSetPeriod( const TickType_t xPeriod, const TickType_t xRelativeDeadline )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		configASSERT( xPeriod > ( TickType_t ) 0 );
+		configASSERT( ( xRelativeDeadline > ( TickType_t ) 0 ) && ( xRelativeDeadline < ( portMAX_DELAY >> 1 ) ) );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB->xEdfPeriod = xPeriod;
+			pxTCB->xEdfRelativeDeadline = xRelativeDeadline;
+			pxTCB->xEdfRelease = xTickCount;
+			pxTCB->xEdfDeadline = pxTCB->xEdfRelease + xRelativeDeadline;
+			pxTCB->uxEdfDeadlineMisses = ( UBaseType_t ) 0;
+
+			/* The running task is in the ready list, move it to the position of
+			its new deadline. */
+			if( pxTCB->uxPriority == ( UBaseType_t ) configPSI_EDF_PRIORITY )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskYIELD_IF_USING_PREEMPTION();
+	}
+
+	BaseType_t xTaskEdfWaitForNextPeriod( void )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	BaseType_t xDeadlineMet = pdTRUE, xAlreadyYielded;
+	TickType_t xLateness;
+
+		configASSERT( pxTCB->xEdfPeriod != ( TickType_t ) 0 );
+
+		/* The work of this period is done, it is late if the deadline passed. */
+		xLateness = xTaskGetTickCount() - pxTCB->xEdfDeadline;
+		if( ( BaseType_t ) xLateness > ( BaseType_t ) 0 )
+		{
+			xDeadlineMet = pdFALSE;
+			( pxTCB->uxEdfDeadlineMisses )++;
+			vApplicationEdfDeadlineMissHook( ( TaskHandle_t ) pxTCB, xLateness );
+		}
+
+		vTaskSuspendAll();
+		{
+			/* Minor optimisation.  The tick count cannot change in this
+			block. */
+			const TickType_t xConstTickCount = xTickCount;
+
+			/* Releases are strictly periodic (same as vTaskDelayUntil()), a late
+			task catches up by starting the next period immediately. */
+			pxTCB->xEdfRelease += pxTCB->xEdfPeriod;
+			pxTCB->xEdfDeadline = pxTCB->xEdfRelease + pxTCB->xEdfRelativeDeadline;
+
+			if( ( BaseType_t ) ( pxTCB->xEdfRelease - xConstTickCount ) > ( BaseType_t ) 0 )
+			{
+				prvAddCurrentTaskToDelayedList( pxTCB->xEdfRelease - xConstTickCount, pdFALSE );
+			}
+			else if( pxTCB->uxPriority == ( UBaseType_t ) configPSI_EDF_PRIORITY )
+			{
+				/* Already released, move the task to the position of its new
+				deadline. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xDeadlineMet;
+	}
+
+	TickType_t xTaskEdfGetPeriod( TaskHandle_t xTask )
+	{
+		return prvGetTCBFromHandle( xTask )->xEdfPeriod;
+	}
+
+	TickType_t xTaskEdfGetDeadline( TaskHandle_t xTask )
+	{
+		return prvGetTCBFromHandle( xTask )->xEdfDeadline;
+	}
+
+	UBaseType_t uxTaskEdfGetDeadlineMisses( TaskHandle_t xTask )
+	{
+		return prvGetTCBFromHandle( xTask )->uxEdfDeadlineMisses;
+	}
+#endif
+
+
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+	BaseType_t xTaskAbortDelayFromISR( TaskHandle_t xTask, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	TCB_t *pxTCB = ( TCB_t * ) xTask;
+	BaseType_t xReturn = pdFAIL;
+	UBaseType_t uxSavedInterruptStatus;
+	List_t *pxStateList;
+
+		configASSERT( pxTCB );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxStateList = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == &xPendingReadyList )
+			{
+				/* The task was already unblocked by an event while the
+				scheduler is suspended, nothing left to abort. */
+				xReturn = pdPASS;
+			}
+			else if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			{
+				/* Event lists of queues and semaphores are modified by tasks
+				with interrupts enabled (only the scheduler is suspended and
+				the queue is locked), they must not be touched here. */
+				xReturn = tskABORT_DELAY_EVENT_WAIT;
+			}
+			else if( taskIS_DELAYED_LIST( pxStateList ) )
+			{
+				xReturn = pdPASS;
+
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, the
+					task is moved when the scheduler is resumed. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					xYieldPending = pdTRUE;
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
 
+	void vTaskResetDelayAborted( void )
+	{
+		taskENTER_CRITICAL();
+		pxCurrentTCB->ucDelayAborted = pdFALSE;
+		taskEXIT_CRITICAL();
+	}
+#endif
+
+#if( configPSI_USE_TICK_CATCH_UP == 1 )
+	static BaseType_t prvCatchUpUnblockTask( TCB_t *pxTCB )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+		if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		prvAddTaskToReadyList( pxTCB );
+
+		#if ( configUSE_PREEMPTION == 1 )
+		{
+			if( taskREADIED_TASK_SWITCH_REQUIRED( pxTCB ) )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		return xSwitchRequired;
+	}
+
+	static BaseType_t prvCatchUpPendedTicks( TickType_t xTicks )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+	#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+		const TickType_t xPendedTicks = xTicks;
+	#endif
+
+		#if( configPSI_USE_DELAY_WHEEL == 1 )
+		{
+		const TickType_t xStartTick = xTickCount;
+		const TickType_t xSlots = ( xTicks < ( TickType_t ) configPSI_DELAY_WHEEL_SLOTS ) ? xTicks : ( TickType_t ) configPSI_DELAY_WHEEL_SLOTS;
+		TickType_t xSlot;
+		List_t *pxSlot;
+		ListItem_t *pxIterator, *pxNextItem;
+
+			xTickCount = xStartTick + xTicks;
+
+			/* The overflows are counted for xTaskCheckForTimeOut(). */
+			if( xTickCount < xStartTick )
+			{
+				xNumOfOverflows++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Each slot is visited once, all tasks of the slot waking within
+			the caught up ticks are unblocked (also across the overflow). */
+			for( xSlot = ( TickType_t ) 1; xSlot <= xSlots; xSlot++ )
+			{
+				pxSlot = &( xDelayWheel[ ( xStartTick + xSlot ) & taskDELAY_WHEEL_MASK ] );
+
+				for( pxIterator = listGET_HEAD_ENTRY( pxSlot ); pxIterator != listGET_END_MARKER( pxSlot ); pxIterator = pxNextItem )
+				{
+					pxNextItem = listGET_NEXT( pxIterator );
+
+					if( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxIterator ) - xStartTick - ( TickType_t ) 1 ) < xTicks )
+					{
+						if( prvCatchUpUnblockTask( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+					}
+				}
+			}
+		}
+		#else
+		{
+		TCB_t *pxTCB;
+		TickType_t xStep;
+
+			while( xTicks > ( TickType_t ) 0 )
+			{
+				/* The delayed lists are switched when the tick count
+				overflows, so the overflow is never passed in one step. */
+				if( xTickCount == portMAX_DELAY )
+				{
+					xTickCount = ( TickType_t ) 0;
+					xStep = ( TickType_t ) 1;
+					taskSWITCH_DELAYED_LISTS();
+				}
+				else
+				{
+					xStep = portMAX_DELAY - xTickCount;
+					if( xStep > xTicks )
+					{
+						xStep = xTicks;
+					}
+					xTickCount += xStep;
+				}
+				xTicks -= xStep;
+
+				/* Unblock all tasks with a wake time up to the new tick count
+				in one pass over the head of the sorted list. */
+				while( xTickCount >= xNextTaskUnblockTime )
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+					{
+						xNextTaskUnblockTime = portMAX_DELAY;
+						break;
+					}
+
+					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+					xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+					if( xTickCount >= xNextTaskUnblockTime )
+					{
+						if( prvCatchUpUnblockTask( pxTCB ) != pdFALSE )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+					}
+				}
+			}
+		}
+		#endif /* configPSI_USE_DELAY_WHEEL */
+
+		#if( configPSI_USE_RESERVATION == 1 )
+		{
+			if( prvReservationTick() != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+		}
+		#endif
+
+		/* Time slicing is only done once for all caught up ticks. */
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		{
+			/* PSI specific: a running task with an active preemption threshold
+			is not time sliced. */
+			#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+				if( taskTHRESHOLD_ACTIVE( pxCurrentTCB ) )
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				else
+			#endif
+			#if( configPSI_USE_EDF == 1 )
+				if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+					( pxCurrentTCB->uxPriority != ( UBaseType_t ) configPSI_EDF_PRIORITY ) )
+			#else
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#endif
+			{
+				#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+				{
+					if( prvTimeSliceElapsed( xPendedTicks ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+				}
+				#else
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		/* The tick hook was not called while the scheduler was suspended. */
+		#if ( ( configUSE_TICK_HOOK == 1 ) && ( configPSI_TICK_CATCH_UP_HOOK == 1 ) )
+		{
+			vApplicationTickHook();
+		}
+		#endif
+
+		return xSwitchRequired;
+	}
+#endif
+
+#if( configPSI_USE_RESERVATION == 1 )
+	/* Execution time consumed in the current period, including the time since
+	the task was switched in if it is running. */
+	static uint32_t prvReservationConsumed( const TCB_t * const pxTCB, const uint32_t ulNow )
+	{
+		if( pxTCB == pxCurrentTCB )
+		{
+			return pxTCB->ulResConsumed + ( ulNow - ulTaskSwitchedInTime );
+		}
+		else
+		{
+			return pxTCB->ulResConsumed;
+		}
+	}
+
+	static uint32_t prvReservationNow( void )
+	{
+	uint32_t ulNow;
+
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+		#else
+			ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		return ulNow;
+	}
+
+	/* Same as vTaskPrioritySet() but only the used priority is changed (the base
+	priority is kept to restore it). */
+	static void prvReservationSetPriority( TCB_t * const pxTCB, const UBaseType_t uxNewPriority )
+	{
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		pxTCB->uxPriority = uxNewPriority;
+
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* Undo the action taken on exhaustion, returns pdTRUE if the task preempts
+	the running task. */
+	static BaseType_t prvReservationRestore( TCB_t * const pxTCB )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		pxTCB->ucResDepleted = pdFALSE;
+
+		if( listIS_CONTAINED_WITHIN( &xReservationDepletedList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+		{
+			( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxTCB );
+			xSwitchRequired = taskPREEMPTS_CURRENT_TASK( pxTCB ) ? pdTRUE : pdFALSE;
+		}
+		else if( pxTCB->uxPriority < pxTCB->uxBasePriority )
+		{
+			prvReservationSetPriority( pxTCB, pxTCB->uxBasePriority );
+			xSwitchRequired = taskPREEMPTS_CURRENT_TASK( pxTCB ) ? pdTRUE : pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSwitchRequired;
+	}
+
+	static BaseType_t prvReservationTick( void )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxIndex;
+	BaseType_t xSwitchRequired = pdFALSE;
+	const uint32_t ulNow = prvReservationNow();
+
+		/* Deferrable server: the full budget is available again at the start of
+		each period, unused budget is not carried over. */
+		for( uxIndex = ( UBaseType_t ) 0; uxIndex < ( UBaseType_t ) configPSI_RESERVATION_MAX_TASKS; uxIndex++ )
+		{
+			pxTCB = pxReservationTasks[ uxIndex ];
+
+			if( ( pxTCB != NULL ) && ( ( BaseType_t ) ( xTickCount - pxTCB->xResReplenishTime ) >= ( BaseType_t ) 0 ) )
+			{
+				pxTCB->xResReplenishTime += pxTCB->xResPeriod;
+
+				/* More than one period passed (e.g. pended ticks). */
+				if( ( BaseType_t ) ( xTickCount - pxTCB->xResReplenishTime ) >= ( BaseType_t ) 0 )
+				{
+					pxTCB->xResReplenishTime = xTickCount + pxTCB->xResPeriod;
+				}
+
+				/* The running task is charged from the replenishment on. */
+				pxTCB->ulResConsumed = ( pxTCB == pxCurrentTCB ) ? ( ulTaskSwitchedInTime - ulNow ) : 0UL;
+
+				if( pxTCB->ucResDepleted != pdFALSE )
+				{
+					if( prvReservationRestore( pxTCB ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+				}
+			}
+		}
+
+		/* Enforce the budget of the running task.  Tasks holding a mutex are
+		not demoted or suspended, that would block all tasks waiting for it. The
+		check is repeated every tick, so the action is also taken again if the
+		priority was restored by a mutex or the task was resumed. */
+		pxTCB = pxCurrentTCB;
+
+		if( ( pxTCB->xResPeriod != ( TickType_t ) 0 ) &&
+			( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 ) &&
+			( prvReservationConsumed( pxTCB, ulNow ) >= pxTCB->ulResBudget ) )
+		{
+			if( pxTCB->ucResDepleted == pdFALSE )
+			{
+				pxTCB->ucResDepleted = pdTRUE;
+				( pxTCB->uxResDepletions )++;
+			}
+
+			/* The running task is not in its ready list if it is about to
+			block (ticks replayed by xTaskResumeAll() or a tick before the
+			yield), it may also be in an event list.  The suspension is deferred
+			to a later tick in which the task runs again. */
+			if( ( pxTCB->ucResAction == ( uint8_t ) eReservationSuspend ) &&
+				( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) == pdFALSE ) )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else if( pxTCB->ucResAction == ( uint8_t ) eReservationSuspend )
+			{
+				if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				vListInsertEnd( &xReservationDepletedList, &( pxTCB->xStateListItem ) );
+				xSwitchRequired = pdTRUE;
+			}
+			else if( pxTCB->uxPriority > ( UBaseType_t ) configPSI_RESERVATION_DEMOTE_PRIORITY )
+			{
+				prvReservationSetPriority( pxTCB, ( UBaseType_t ) configPSI_RESERVATION_DEMOTE_PRIORITY );
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xSwitchRequired;
+	}
+
+	BaseType_t xTaskSetReservation( TaskHandle_t xTask, const TickType_t xPeriod, const uint32_t ulBudget, const eReservationAction eAction )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxIndex, uxFree = ( UBaseType_t ) configPSI_RESERVATION_MAX_TASKS;
+	BaseType_t xReturn = pdPASS;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Suspending the idle task would leave no task to run. */
+			configASSERT( pxTCB != xIdleTaskHandle );
+
+			for( uxIndex = ( UBaseType_t ) 0; uxIndex < ( UBaseType_t ) configPSI_RESERVATION_MAX_TASKS; uxIndex++ )
+			{
+				if( pxReservationTasks[ uxIndex ] == pxTCB )
+				{
+					pxReservationTasks[ uxIndex ] = NULL;
+					uxFree = uxIndex;
+				}
+				else if( ( pxReservationTasks[ uxIndex ] == NULL ) && ( uxFree == ( UBaseType_t ) configPSI_RESERVATION_MAX_TASKS ) )
+				{
+					uxFree = uxIndex;
+				}
+			}
+
+			/* Undo a pending exhaustion action, the new reservation starts
+			with the full budget. */
+			if( ( pxTCB->ucResDepleted != pdFALSE ) && ( prvReservationRestore( pxTCB ) != pdFALSE ) )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+
+			if( xPeriod == ( TickType_t ) 0 )
+			{
+				pxTCB->xResPeriod = ( TickType_t ) 0;
+			}
+			else if( uxFree == ( UBaseType_t ) configPSI_RESERVATION_MAX_TASKS )
+			{
+				pxTCB->xResPeriod = ( TickType_t ) 0;
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxTCB->xResPeriod = xPeriod;
+				pxTCB->xResReplenishTime = xTickCount + xPeriod;
+				pxTCB->ulResBudget = ulBudget;
+				pxTCB->ulResConsumed = ( pxTCB == pxCurrentTCB ) ? ( ulTaskSwitchedInTime - prvReservationNow() ) : 0UL;
+				pxTCB->uxResDepletions = ( UBaseType_t ) 0;
+				pxTCB->ucResAction = ( uint8_t ) eAction;
+				pxReservationTasks[ uxFree ] = pxTCB;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+	uint32_t ulTaskGetReservationConsumed( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	uint32_t ulReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			ulReturn = prvReservationConsumed( pxTCB, prvReservationNow() );
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+	TickType_t xTaskGetReservationPeriod( TaskHandle_t xTask )
+	{
+		return prvGetTCBFromHandle( xTask )->xResPeriod;
+	}
+
+	uint32_t ulTaskGetReservationBudget( TaskHandle_t xTask )
+	{
+		return prvGetTCBFromHandle( xTask )->ulResBudget;
+	}
+
+	UBaseType_t uxTaskGetReservationDepletions( TaskHandle_t xTask )
+	{
+		return prvGetTCBFromHandle( xTask )->uxResDepletions;
+	}
+#endif
+
+#if( configPSI_USE_TASK_POOL == 1 )
+	static void prvTaskPoolRelease( TCB_t *pxTCB )
+	{
+		/* Called in a critical section or from the context switch. */
+		uxTaskPoolReleasedSlots[ uxTaskPoolReleased ] = ( UBaseType_t ) ( pxTCB - &( xTaskPoolTCBs[ 0 ] ) );
+		uxTaskPoolReleased++;
+	}
+
+	BaseType_t xTaskCreateFromPool(	TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask )
+	{
+	TCB_t *pxNewTCB = NULL;
+	UBaseType_t uxSlot = ( UBaseType_t ) configPSI_TASK_POOL_SIZE;
+	UBaseType_t uxFree;
+	BaseType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			if( uxTaskPoolReleased > ( UBaseType_t ) 0U )
+			{
+				uxTaskPoolReleased--;
+				uxSlot = uxTaskPoolReleasedSlots[ uxTaskPoolReleased ];
+			}
+			else if( uxTaskPoolNeverUsed < ( UBaseType_t ) configPSI_TASK_POOL_SIZE )
+			{
+				uxSlot = uxTaskPoolNeverUsed;
+				uxTaskPoolNeverUsed++;
+			}
+			else
+			{
+				uxTaskPoolFailures++;
+			}
+
+			uxFree = uxTaskPoolReleased + ( ( UBaseType_t ) configPSI_TASK_POOL_SIZE - uxTaskPoolNeverUsed );
+			if( uxFree < uxTaskPoolMinimumEverFree )
+			{
+				uxTaskPoolMinimumEverFree = uxFree;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( uxSlot < ( UBaseType_t ) configPSI_TASK_POOL_SIZE )
+		{
+			pxNewTCB = &( xTaskPoolTCBs[ uxSlot ] );
+			pxNewTCB->pxStack = &( xTaskPoolStacks[ uxSlot ][ 0 ] );
+
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
+			{
+				/* Never freed, pool slots are released by prvDeleteTCB(). */
+				pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+			#endif
+
+			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) ( configPSI_TASK_POOL_STACK_DEPTH + taskSTACK_GUARD_WORDS ), pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+			prvAddNewTaskToReadyList( pxNewTCB );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		}
+
+		return xReturn;
+	}
+
+	UBaseType_t uxTaskPoolGetFreeSlots( void )
+	{
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			uxReturn = uxTaskPoolReleased + ( ( UBaseType_t ) configPSI_TASK_POOL_SIZE - uxTaskPoolNeverUsed );
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+	UBaseType_t uxTaskPoolGetMinimumEverFreeSlots( void )
+	{
+		return uxTaskPoolMinimumEverFree;
+	}
+
+	UBaseType_t uxTaskPoolGetFailures( void )
+	{
+		return uxTaskPoolFailures;
+	}
+#endif
+
+#if( configPSI_USE_TIME_SLICE_QUANTUM == 1 )
+	static BaseType_t prvTimeSliceElapsed( const TickType_t xTicks )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		pxCurrentTCB->uxTimeSliceTicks += ( UBaseType_t ) xTicks;
+
+		if( pxCurrentTCB->uxTimeSliceTicks >= pxCurrentTCB->uxTimeSliceQuantum )
+		{
+			pxCurrentTCB->uxTimeSliceTicks = ( UBaseType_t ) 0;
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+	void vTaskSetTimeSliceQuantum( TaskHandle_t xTask, const UBaseType_t uxQuantum )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( uxQuantum > ( UBaseType_t ) 0 );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxTimeSliceQuantum = uxQuantum;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	UBaseType_t uxTaskGetTimeSliceQuantum( TaskHandle_t xTask )
+	{
+		return prvGetTCBFromHandle( xTask )->uxTimeSliceQuantum;
+	}
+#endif
+
+#if( configPSI_USE_PREEMPTION_THRESHOLD == 1 )
+	static BaseType_t prvPreemptionThresholdHolds( void )
+	{
+	UBaseType_t uxTopPriority;
+	BaseType_t xReturn = pdFALSE;
+
+		/* A task that blocked, was suspended or deleted is not in its ready
+		list anymore and is replaced as usual. */
+		if( ( taskTHRESHOLD_ACTIVE( pxCurrentTCB ) ) &&
+			( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+		{
+			#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+			{
+				/* uxTopReadyPriority is only an upper bound, the list of the
+				running task is not empty. */
+				uxTopPriority = uxTopReadyPriority;
+				while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) )
+				{
+					--uxTopPriority;
+				}
+			}
+			#else
+			{
+				portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+			}
+			#endif
+
+			if( uxTopPriority <= pxCurrentTCB->uxPreemptionThreshold )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+	void vTaskSetPreemptionThreshold( TaskHandle_t xTask, UBaseType_t uxThreshold )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( ( uxThreshold < configMAX_PRIORITIES ) );
+
+		if( uxThreshold >= ( UBaseType_t ) configMAX_PRIORITIES )
+		{
+			uxThreshold = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxPreemptionThreshold = uxThreshold;
+
+			/* Lowering the threshold of the running task may allow a ready task
+			to preempt it. */
+			if( ( pxTCB == pxCurrentTCB ) && ( xSchedulerRunning != pdFALSE ) )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	UBaseType_t uxTaskGetPreemptionThreshold( TaskHandle_t xTask )
+	{
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			uxReturn = taskPREEMPTION_LIMIT( prvGetTCBFromHandle( xTask ) );
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+#endif